@@ -63,7 +63,7 @@
 
 #include <sensor_msgs/JointState.h>
 #include <std_msgs/Bool.h>
-#include <diagnostic_msgs/DiagnosticArray.h>
+#include <seneka_diagnostics/DiagnosticsAggregator.h>
 #include <trajectory_msgs/JointTrajectory.h>
 #include <seneka_control_interface/JointTrajectoryAction.h>
 #include <control_msgs/FollowJointTrajectoryAction.h>
@@ -80,7 +80,8 @@ using namespace std;
 
 class ControlNode {
 	ros::NodeHandle nh_;
-	ros::Publisher pub_joints_, pub_diag_;
+	ros::Publisher pub_joints_;
+	DiagnosticsAggregator diagnostics_;	///< status of the joints, published once per second
 	std::vector<boost::shared_ptr<ros::Publisher> > pub_btns_;
 	ros::Subscriber sub_joint_path_command_;///< subscriber for a trajectory
 	sensor_msgs::JointState joint_state_;
@@ -145,7 +146,7 @@ public:
 		updated_(false)
 	{
 		pub_joints_  = nh_.advertise<sensor_msgs::JointState>("/joint_states", 10);
-		pub_diag_ = nh_.advertise<diagnostic_msgs::DiagnosticArray> ("/diagnostics", 1);
+		diagnostics_.start(nh_, "/diagnostics", 1.0);
 		sub_joint_path_command_ = nh_.subscribe("joint_path_command", 1, &ControlNode::cb_joint_path_command, this);
 		
 		ros::NodeHandle pnh("~");	//parameter lookup in local namespace
@@ -355,23 +356,14 @@ public:
 			}
 			updated_ = false;
 		}
-		// publishing diagnotic messages
-		diagnostic_msgs::DiagnosticArray diagnostics;
-		diagnostics.status.resize(joint_state_.name.size());
-
-		// set data to diagnostics
+		// update diagnostics, they are published by the aggregator at a lower rate
 		size_t j=0;
 		for(size_t i=0; i<devices_.size(); i++) {
-			for(size_t k=0; k<devices_[i]->getNumJoints(); k++) {
-				diagnostics.status[j].level = devices_[i]->error()?2:1;
-				diagnostics.status[j].name = joint_state_.name[j];
-				diagnostics.status[j].message = devices_[i]->error()?"error":"ok";
+			for(size_t k=0; k<devices_[i]->getNumJoints() && j<joint_state_.name.size(); k++) {
+				diagnostics_.setStatus(joint_state_.name[j], devices_[i]->error()?2:1, devices_[i]->error()?"error":"ok");
 				++j;
 			}
 		}
-		
-		// publish diagnostic message
-		pub_diag_.publish(diagnostics);
 
 		if(testing_) {
 			std::cout<<"testing..."<<std::endl;
@@ -63,7 +63,13 @@
 /*************** includes ***************/
 /****************************************/
 
-#include <boost/asio/serial_port.hpp>
+#include <boost/thread.hpp>
+
+#include <seneka_serial/SerialPort.h>
+#include <seneka_diagnostics/StatementRing.h>
+#include <seneka_dgps/PacketFramer.h>
+#include <seneka_dgps/RecordAssembler.h>
+#include <seneka_dgps/LatestValue.h>
 
 #include <sstream>
 #include <string>
@@ -112,14 +118,12 @@ class Dgps {
 
         };
 
-        struct DiagnosticStatement {
-
-            std::string     diagnostic_message;
-            DiagnosticFlag  diagnostic_flag;
+        // the latest 100 statements, repeated statements are merged (see seneka_diagnostics/StatementRing.h);
+        // taken out and cleared by SenekaDgps::extractDiagnostics();
+        typedef StatementRing<DiagnosticFlag, 100>  DiagnosticArray;
+        typedef DiagnosticArray::Statement          DiagnosticStatement;
 
-        };
-
-        std::vector<DiagnosticStatement> diagnostic_array;
+        DiagnosticArray diagnostic_array;
 
         /*********************************************/
         /*************** data handling ***************/
@@ -152,6 +156,17 @@ class Dgps {
         };
 
        
+        // RAWDATA (57h) RECORD;
+        // a raw data record of any type, reassembled from the data parts of its pages (see RecordAssembler.h);
+        struct RawRecord {
+
+            unsigned char               record_type;                    // 01h: position record, see Trimble BD982 GNSS Receiver manual, p. 132
+            unsigned char               record_interpretation_flags;
+            std::vector<unsigned char>  data;                           // record data of all pages
+            boost::system_time          arrival_time;                   // arrival of the last page
+
+        };
+
         // RAWDATA (57h) PACKET - POSITION RECORD - DATA PART;
         // the structure below contains all the INTERPRETED data bytes of a position record packet data field; 
         // position record (packet type: 57h, see Trimble BD982 GNSS Receiver manual, p. 139);
@@ -178,22 +193,52 @@ class Dgps {
         /**************************************************/
         /**************************************************/
 
-        // establishes serial connection;
+        // establishes serial connection and starts reading;
         bool open(const char* pcPort, int iBaudRate);
 
+        // stops reading and closes the serial connection;
+        void close();
+
         // tests the communication link by sending protocol request "ENQ" (05h);
         // expects to receive "ACK" (06h);
         // see Trimble BD982 GNSS receiver manual, p. 65;
         bool checkConnection();
 
         // requests GPS data from GPS device;
-        // hereby called functions analyze the received packet in-depth, structure it, extract and finnaly serve GPS data;
+        // all record types given by setRecordTypes() are requested at once ("GETRAW" (56h) requests sent back-to-back),
+        // so that further record types do not cost further round trips; the replies are reassembled from their pages
+        // and stored in the record cache (see getRecord());
+        // hereby called functions analyze the position record in-depth, structure it, extract and finnaly serve GPS data;
         // if everything works fine, GPS data is getting stored in Dgps::GpsData gps_data;
+        // returns false if the position record is missing; missing records of other types are only reported;
         bool getDgpsData();
 
+        // raw data types requested by getDgpsData(), 00h to 0Fh; default is the position record (01h) only;
+        // the position record is always added, since getDgpsData() serves its data;
+        // the record type of a reply equals the requested raw data type;
+        void setRecordTypes(const std::vector<unsigned char> & record_types);
+        std::vector<unsigned char> getRecordTypes() {return record_types;}
+
+        // latest record of the given type from the record cache, which the reactor thread fills lock-free;
+        // returns false if no record of this type has been received yet;
+        // the cache has a single reader, so this has to be called by the thread which calls getDgpsData();
+        bool getRecord(unsigned char record_type, RawRecord & record);
+
+        // streaming mode: waits up to timeout ms for the next position record which the receiver sends on its own
+        // (periodic "RAWDATA" (57h) position record output enabled in the receiver configuration);
+        // the packet is parsed as soon as it arrives, results are stored like getDgpsData() does;
+        // also called by getDgpsData() for the requested reply;
+        bool receiveDgpsData(int timeout);
+
         // getters;
         GpsData getPosition() {return gps_data;}
 
+        // time at which the last byte of the last parsed position record was received;
+        boost::system_time getArrivalTime() {return arrival_time;}
+
+        // streamed position records which were replaced by a newer one before they were parsed;
+        unsigned long getOverwrittenPackets() {boost::mutex::scoped_lock lock(response_mutex); return overwritten_packets;}
+
         // helper functions;
 
         // for some reason, instead of just responding the requested "RAWDATA" (57h) position record packet, 
@@ -201,6 +246,7 @@ class Dgps {
         // these 16 bytes of data form another separate packet, including header, data part and tail;
         // for now, I couldn't figure out why;
         // to avoid this kind of mistake, the following workaround is necessary;
+        // (not used anymore, PacketFramer skips such packets)
         std::vector<unsigned char> debugBuffer(unsigned char * buffer);
 
         enum DataType {
@@ -213,6 +259,9 @@ class Dgps {
 
         };
 
+        // bit-wise decoding of single fields, extractGpsData() uses RecordDecoder (see RecordDecoder.h) instead;
+        // kept as reference for common/src/recordDecoderBenchmark.cpp;
+
         // function to reorder incoming bits;
         std::vector<bool>  invertBitOrder      (bool * bits, DataType data_type, bool invertBitsPerByte = true, bool invertByteOrder = false);
         // function to extract numbers of data type CHAR;
@@ -228,32 +277,86 @@ class Dgps {
 
     private:
 
-        // serial input/output instance;
-        boost::asio::io_service io_service_;
-        boost::asio::serial_port m_SerialIO;
+        // serial input/output instance, read by the shared reactor thread (see seneka_serial/SerialPort.h);
+        SerialPort                  serial_port;
+
+        /*********************************************/
+        /*************** serial reader ***************/
+        /*********************************************/
+
+        // all received bytes are read continuously by the reactor thread and fed into the framer;
+        // "RAWDATA" (57h) packets are reassembled to records, complete records go to the record cache;
+        // the latest "ACK"/"NAK" byte is kept for the requesting functions;
+        PacketFramer                framer;
+        RecordAssembler             assembler;
+
+        // latest record per record type; written by the reactor thread, read by the requesting thread;
+        LatestValue<RawRecord>      record_cache[RecordAssembler::max_record_type + 1];
+
+        boost::mutex                response_mutex;         // guards the members below
+        boost::condition_variable   response_condition;
+        unsigned long               record_counts[RecordAssembler::max_record_type + 1];   // received records per type
+        unsigned long               awaited_counts[RecordAssembler::max_record_type + 1];  // record_counts when requested
+        std::vector<unsigned char>  awaited_types;          // record types of the pending request
+        unsigned long               request_resyncs;        // framer resyncs when the request was sent
+        bool                        position_pending;       // a position record was received and not taken yet
+        PacketFramer::Event         control_response;       // ACK, NAK or NONE
+        unsigned long               nak_count;              // NAKs since the last request
+        bool                        read_failed;
+        std::string                 read_error_message;     // cause of the read failure
+        PacketFramer::Statistics    framer_statistics;      // copy of the framer statistics
+        RecordAssembler::Statistics assembler_statistics;   // copy of the assembler statistics
+        boost::system_time          last_read_time;
+        unsigned long               overwritten_packets;
+
+        boost::system_time          arrival_time;           // of the last parsed packet
+
+        unsigned long               reported_resyncs;
+        unsigned long               reported_dropped_records;
+
+        std::vector<unsigned char>  record_types;           // requested by getDgpsData()
+
+        // called by the reactor thread for every received chunk of bytes;
+        void handleReceive(const unsigned char * data, size_t size);
+
+        // called by the reactor thread if reading from the serial port fails;
+        void handleReadError(const boost::system::error_code & ec);
+
+        // takes the complete packets out of the framer, response_mutex has to be locked;
+        void processFrames();
+
+        // forgets older responses before a request is sent;
+        void clearResponses();
+
+        enum Response {
+
+            CONTROL,    // "ACK" or "NAK"
+            POSITION,   // position record or "NAK"
+            RECORDS     // all awaited_types, a "NAK" answers one of them
+
+        };
+
+        // true if the response is complete, response_mutex has to be locked;
+        bool responseComplete(Response response);
+
+        // waits up to timeout ms for the response;
+        bool waitForResponse(Response response, int timeout);
 
         /*********************************************/
         /*************** data handling ***************/
         /*********************************************/
 
         // see comments at corresponding structure definition above;
-        PacketData          temp_packet;
         GpsData             gps_data;
 
-        // analyzes received data packets in-depth, structures it and serves PacketData incoming_packet;
-        bool analyzeData(unsigned char *  incoming_data,
-                         int              incoming_data_length);
-
-        // takes PacketData incoming_packet from analyzeData(),
+        // takes a position record from the record cache,
         // extracts and finally serves GpsData gps_data;
-        bool extractGpsData();
+        bool extractGpsData(const RawRecord & record);
 
         /****************************************************/
         /*************** diagnostics handling ***************/
         /****************************************************/
 
-        DiagnosticStatement diagnostic_statement;
-        
         // helper variables which store diagnostic messages temporarily;
         std::stringstream msg;
         std::stringstream msg_tagged;
@@ -0,0 +1,221 @@
+/*!
+*****************************************************************
+* GpsTime.h
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_dgps
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description: The seneka_dgps package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* It implements a GNU/Linux driver for the Trimble BD982 GNSS Receiver Module as well as a ROS publisher node "DGPS", which acts as a wrapper for the driver.
+* The ROS node "DGPS" publishes GPS data gathered by the DGPS device driver.
+* This package might work with other hardware and can be used for other purposes, however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef GPS_TIME_H_
+#define GPS_TIME_H_
+
+/****************************************/
+/*************** includes ***************/
+/****************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+/*********************************************/
+/*************** GpsTime class ***************/
+/*********************************************/
+
+// converts the GPS time of a record (ms of the week) to UTC in s since 1970 and tracks the offset of the host clock;
+// the position record carries no week number, so the week is the one which puts the epoch closest to a reference time
+// (the arrival of the record on the host clock); this only fails if the host clock is off by more than half a week;
+// GPS time does not contain leap seconds, the difference to UTC is taken from the table below
+// or from a fixed value, e.g. if a leap second was introduced after the table;
+// clock offset: the arrival of a record minus its epoch is the output and transfer latency of the receiver
+// plus the offset of the host clock against GPS time; the smallest of the last samples is the best estimate
+// of the offset, since the latency only ever adds to it; if it exceeds max_clock_offset, the host clock
+// is not synchronized and the epochs are moved onto the host clock by it;
+// times are given in s, the class does not depend on ROS;
+class GpsTime {
+
+    public:
+
+        // leap_seconds:        GPS time minus UTC in s, negative values use the table;
+        // max_clock_offset:    [] = s; largest offset of a host clock which is considered synchronized to GPS time;
+        // window:              number of records the clock offset is tracked over;
+        GpsTime(int leap_seconds = -1, double max_clock_offset = 1.0, size_t window = 20)
+            : leap_seconds_(leap_seconds), max_clock_offset_(max_clock_offset), window_(std::max(window, (size_t) 1)) {
+
+            reset();
+
+        }
+
+        void reset() {
+
+            offsets_.clear();
+            clock_offset_   = 0.0;
+            latency_        = 0.0;
+            week_           = -1;
+
+        }
+
+        // GPS time minus UTC in s at the given GPS time (s since the GPS epoch);
+        int leapSeconds(double gps_time) const {
+
+            // beginnings of the leap second periods in UTC, s since the GPS epoch (06.01.1980);
+            static const double leap_second_dates[] = {
+
+                46828800.0,     // 01.07.1981
+                78364800.0,     // 01.07.1982
+                109900800.0,    // 01.07.1983
+                173059200.0,    // 01.07.1985
+                252028800.0,    // 01.01.1988
+                315187200.0,    // 01.01.1990
+                346723200.0,    // 01.01.1991
+                393984000.0,    // 01.07.1992
+                425520000.0,    // 01.07.1993
+                457056000.0,    // 01.07.1994
+                504489600.0,    // 01.01.1996
+                551750400.0,    // 01.07.1997
+                599184000.0,    // 01.01.1999
+                820108800.0,    // 01.01.2006
+                914803200.0,    // 01.01.2009
+                1025136000.0,   // 01.07.2012
+                1119744000.0,   // 01.07.2015
+                1167264000.0    // 01.01.2017
+
+            };
+
+            if (leap_seconds_ >= 0)
+                return leap_seconds_;
+
+            int leap_seconds = 0;
+
+            for (int i = 0; i < (int) (sizeof(leap_second_dates) / sizeof(leap_second_dates[0])); i++) {
+
+                if (gps_time - (i + 1) >= leap_second_dates[i])
+                    leap_seconds = i + 1;
+
+            }
+
+            return leap_seconds;
+
+        }
+
+        // UTC (s since 1970) of a GPS time in ms of the week, with the week closest to reference (UTC, s since 1970);
+        // returns -1.0 for an invalid time of the week;
+        double toUtc(long gps_msec_of_week, double reference) {
+
+            if (gps_msec_of_week < 0 || gps_msec_of_week >= week_msec)
+                return -1.0;
+
+            double reference_gps    = reference - gps_epoch;
+            reference_gps          += leapSeconds(reference_gps + leapSeconds(reference_gps));
+
+            double time_of_week     = gps_msec_of_week / 1000.0;
+
+            week_                   = (long) std::floor((reference_gps - time_of_week) / week_seconds + 0.5);
+
+            double gps_time         = week_ * week_seconds + time_of_week;
+
+            return gps_time - leapSeconds(gps_time) + gps_epoch;
+
+        }
+
+        // time stamp of a record on the host clock (s since 1970) from its GPS time and its arrival on the host clock;
+        // updates the clock offset; returns the arrival time itself for an invalid time of the week;
+        double stamp(long gps_msec_of_week, double arrival) {
+
+            double epoch = toUtc(gps_msec_of_week, arrival);
+
+            if (epoch < 0.0)
+                return arrival;
+
+            latency_ = arrival - epoch;
+
+            offsets_.push_back(latency_);
+
+            if (offsets_.size() > window_)
+                offsets_.pop_front();
+
+            clock_offset_ = *std::min_element(offsets_.begin(), offsets_.end());
+
+            if (!synchronized())
+                epoch += clock_offset_;
+
+            return epoch;
+
+        }
+
+        // host clock minus GPS time (as UTC) in s, including the smallest latency of the receiver;
+        double clockOffset() const {return clock_offset_;}
+
+        // true if the epochs are used on the host clock without correction;
+        bool synchronized() const {return std::fabs(clock_offset_) <= max_clock_offset_;}
+
+        // arrival of the last record minus its epoch in s;
+        double latency() const {return latency_;}
+
+        // GPS week of the last converted time, -1 before the first one;
+        long week() const {return week_;}
+
+    private:
+
+        static const long   week_msec       = 604800000L;
+        static const long   week_seconds    = 604800L;
+        static const long   gps_epoch       = 315964800L;   // [] = s; 06.01.1980 in s since 1970
+
+        int                 leap_seconds_;
+        double              max_clock_offset_;
+        size_t              window_;
+
+        std::deque<double>  offsets_;
+        double              clock_offset_;
+        double              latency_;
+        long                week_;
+
+};
+
+#endif // GPS_TIME_H_
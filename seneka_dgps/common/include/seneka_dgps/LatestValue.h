@@ -0,0 +1,133 @@
+/*!
+*****************************************************************
+* LatestValue.h
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_dgps
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description: The seneka_dgps package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* It implements a GNU/Linux driver for the Trimble BD982 GNSS Receiver Module as well as a ROS publisher node "DGPS", which acts as a wrapper for the driver.
+* The ROS node "DGPS" publishes GPS data gathered by the DGPS device driver.
+* This package might work with other hardware and can be used for other purposes, however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef LATEST_VALUE_H_
+#define LATEST_VALUE_H_
+
+/****************************************/
+/*************** includes ***************/
+/****************************************/
+
+#include <boost/atomic.hpp>
+
+/*************************************************/
+/*************** LatestValue class ***************/
+/*************************************************/
+
+// lock-free exchange of the latest value between one writer thread and one reader thread (triple buffer);
+// the writer fills its own slot and swaps it with the middle slot, the reader swaps its slot with the middle
+// slot if that holds a newer value; neither side ever waits and a slot is only used by one side at a time,
+// so values which allocate memory (e.g. vectors) are fine and keep their capacity when they are reused;
+// values the reader does not take in time are replaced by newer ones;
+template <typename T>
+class LatestValue {
+
+    public:
+
+        LatestValue() : middle_(1), back_(0), front_(2), valid_(false) {}
+
+        /*************** writer ***************/
+
+        // slot of the writer, to be filled before publish();
+        T & back() {return slots_[back_];}
+
+        // makes the value in back() the latest one;
+        void publish() {
+
+            back_ = middle_.exchange(back_ | FRESH, boost::memory_order_acq_rel) & INDEX;
+
+        }
+
+        void set(const T & value) {
+
+            back() = value;
+            publish();
+
+        }
+
+        /*************** reader ***************/
+
+        // takes the latest value if there is a newer one than front(); returns true if so;
+        bool update() {
+
+            if (!(middle_.load(boost::memory_order_acquire) & FRESH))
+                return false;
+
+            front_ = middle_.exchange(front_, boost::memory_order_acq_rel) & INDEX;
+            valid_ = true;
+
+            return true;
+
+        }
+
+        // value taken by the last update(); valid() is false until a value has been taken;
+        const T & front() const {return slots_[front_];}
+
+        bool valid() const {return valid_;}
+
+    private:
+
+        static const unsigned int INDEX = 3;
+        static const unsigned int FRESH = 4;
+
+        T                           slots_[3];
+        boost::atomic<unsigned int> middle_;    // index of the middle slot, FRESH if the writer published it
+        unsigned int                back_;      // writer only
+        unsigned int                front_;     // reader only
+        bool                        valid_;     // reader only
+
+};
+
+#endif // LATEST_VALUE_H_
@@ -0,0 +1,317 @@
+/*!
+*****************************************************************
+* PacketFramer.h
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_dgps
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description: The seneka_dgps package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* It implements a GNU/Linux driver for the Trimble BD982 GNSS Receiver Module as well as a ROS publisher node "DGPS", which acts as a wrapper for the driver.
+* The ROS node "DGPS" publishes GPS data gathered by the DGPS device driver.
+* This package might work with other hardware and can be used for other purposes, however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef PACKET_FRAMER_H_
+#define PACKET_FRAMER_H_
+
+/****************************************/
+/*************** includes ***************/
+/****************************************/
+
+#include <stddef.h>
+#include <cstring>
+
+/**************************************************/
+/*************** PacketFramer class ***************/
+/**************************************************/
+
+// incremental framer for the Trimble data collector protocol;
+// received bytes are appended to a ring buffer in any chunking, complete packets are taken out one by one;
+// packet: stx (02h), status, packet type, length, <length> data bytes, checksum, etx (03h);
+// the checksum is the sum of status, packet type, length and data bytes modulo 256;
+// see Trimble BD982 GNSS Receiver Manual, p. 65ff;
+// a candidate packet with an invalid length, checksum or etx costs a resync only: its stx is dropped
+// and the search starts again at the next byte, so a packet within the garbage is found as well;
+// a garbage stx may announce a length which swallows the following packet; if no further bytes arrive,
+// the owner of the framer calls dropCandidate() after an idle gap of the link to search again;
+// single "ACK" (06h) and "NAK" (15h) bytes outside of packets are reported as events;
+class PacketFramer {
+
+    public:
+
+        enum Event {
+
+            NONE,       // no complete packet available yet
+            PACKET,     // packet() holds a valid packet
+            ACK,
+            NAK
+
+        };
+
+        struct Statistics {
+
+            unsigned long packets;
+            unsigned long resyncs;              // rejected candidate packets
+            unsigned long discarded_bytes;      // bytes outside of packets (including ACK/NAK)
+            unsigned long overflows;            // bytes lost because the ring buffer was full
+
+        };
+
+        static const unsigned char STX = 0x02;
+        static const unsigned char ETX = 0x03;
+        static const unsigned char ACK_BYTE = 0x06;
+        static const unsigned char NAK_BYTE = 0x15;
+
+        // 4 bytes header, up to 255 data bytes, checksum and etx;
+        static const size_t max_packet_size = 4 + 255 + 2;
+
+        // size of the ring buffer, has to be a power of 2;
+        static const size_t capacity = 1024;
+
+        // max_length: maximum accepted value of the length byte;
+        PacketFramer(unsigned int max_length = 255) : max_length_(max_length) {
+
+            reset();
+
+        }
+
+        // drops all buffered bytes;
+        void reset() {
+
+            read_ = 0;
+            size_ = 0;
+            state_ = SEARCH_STX;
+            parsed_ = 0;
+            packet_size_ = 0;
+            std::memset(&statistics_, 0, sizeof(statistics_));
+
+        }
+
+        // appends received bytes; if the ring buffer is full, the oldest bytes are dropped;
+        void push(const unsigned char * data, size_t size) {
+
+            for (size_t i = 0; i < size; i++) {
+
+                if (size_ == capacity) {
+
+                    consume(1);
+                    state_ = SEARCH_STX;
+                    parsed_ = 0;
+                    statistics_.overflows++;
+
+                }
+
+                ring_[(read_ + size_) & (capacity - 1)] = data[i];
+                size_++;
+
+            }
+
+        }
+
+        // processes the buffered bytes up to the next event;
+        // bytes of an incomplete packet stay in the ring buffer until the next push;
+        Event next() {
+
+            while (parsed_ < size_) {
+
+                unsigned char byte = at(parsed_);
+
+                switch (state_) {
+
+                    case SEARCH_STX:
+
+                        // the stx stays in the ring buffer until the packet is complete or rejected;
+                        if (byte == STX) {
+                            state_ = HEADER;
+                            checksum_ = 0;
+                            parsed_ = 1;
+                            break;
+                        }
+
+                        consume(1);
+                        statistics_.discarded_bytes++;
+
+                        if (byte == ACK_BYTE) return ACK;
+                        if (byte == NAK_BYTE) return NAK;
+
+                        break;
+
+                    case HEADER:
+
+                        // status, packet type and length;
+                        checksum_ += byte;
+                        parsed_++;
+
+                        if (parsed_ == 4) {
+                            length_ = byte;
+                            if (length_ > max_length_) resync();
+                            else state_ = (length_ > 0) ? DATA : CHECKSUM;
+                        }
+
+                        break;
+
+                    case DATA:
+
+                        checksum_ += byte;
+                        parsed_++;
+
+                        if (parsed_ == 4 + length_) state_ = CHECKSUM;
+
+                        break;
+
+                    case CHECKSUM:
+
+                        if (byte != checksum_) {
+                            resync();
+                        }
+                        else {
+                            parsed_++;
+                            state_ = END;
+                        }
+
+                        break;
+
+                    case END:
+
+                        if (byte != ETX) {
+                            resync();
+                            break;
+                        }
+
+                        packet_size_ = parsed_ + 1;
+                        for (size_t i = 0; i < packet_size_; i++)
+                            packet_[i] = at(i);
+
+                        consume(packet_size_);
+                        state_ = SEARCH_STX;
+                        parsed_ = 0;
+                        statistics_.packets++;
+
+                        return PACKET;
+
+                }
+
+            }
+
+            return NONE;
+
+        }
+
+        // true if the buffered bytes start with an incomplete candidate packet;
+        bool pending() const {
+
+            return state_ != SEARCH_STX;
+
+        }
+
+        // rejects an incomplete candidate packet (e.g. if the link is idle), next() searches again behind its stx;
+        void dropCandidate() {
+
+            if (state_ != SEARCH_STX)
+                resync();
+
+        }
+
+        // last packet returned by next();
+        const unsigned char * packet() const        {return packet_;}
+        size_t packetSize() const                   {return packet_size_;}
+
+        const Statistics & statistics() const       {return statistics_;}
+
+    private:
+
+        enum State {
+
+            SEARCH_STX,
+            HEADER,
+            DATA,
+            CHECKSUM,
+            END
+
+        };
+
+        unsigned char at(size_t i) const {
+
+            return ring_[(read_ + i) & (capacity - 1)];
+
+        }
+
+        void consume(size_t n) {
+
+            read_ = (read_ + n) & (capacity - 1);
+            size_ -= n;
+
+        }
+
+        // rejects the current candidate: drops its stx and searches again from the following byte;
+        void resync() {
+
+            consume(1);
+            state_ = SEARCH_STX;
+            parsed_ = 0;
+            statistics_.resyncs++;
+            statistics_.discarded_bytes++;
+
+        }
+
+        unsigned int    max_length_;
+
+        unsigned char   ring_[capacity];
+        size_t          read_;      // index of the first buffered byte
+        size_t          size_;      // number of buffered bytes
+
+        State           state_;
+        size_t          parsed_;    // bytes of the current candidate which have been examined
+        size_t          length_;
+        unsigned char   checksum_;
+
+        unsigned char   packet_[max_packet_size];
+        size_t          packet_size_;
+
+        Statistics      statistics_;
+
+};
+
+#endif // PACKET_FRAMER_H_
@@ -0,0 +1,207 @@
+/*!
+*****************************************************************
+* PositionEstimator.h
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_dgps
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description: The seneka_dgps package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* It implements a GNU/Linux driver for the Trimble BD982 GNSS Receiver Module as well as a ROS publisher node "DGPS", which acts as a wrapper for the driver.
+* The ROS node "DGPS" publishes GPS data gathered by the DGPS device driver.
+* This package might work with other hardware and can be used for other purposes, however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef POSITION_ESTIMATOR_H_
+#define POSITION_ESTIMATOR_H_
+
+/****************************************/
+/*************** includes ***************/
+/****************************************/
+
+#include <seneka_dgps/Dgps.h>
+
+#include <algorithm>
+#include <cmath>
+
+/*******************************************************/
+/*************** PositionEstimator class ***************/
+/*******************************************************/
+
+// predicts the position between two receiver epochs from the latest fix and its rates;
+// the position record carries latitude and longitude rate in rad/s and altitude rate in m/s
+// (see Trimble BD982 GNSS Receiver Manual, p. 140), so the prediction is a linear extrapolation;
+// each new fix replaces the prediction (correction), the difference between both is the prediction error;
+// variance of the estimate: (pdop * uere)^2 of the fix plus (rate error * age)^2, i.e. it grows with the age;
+// the rate error is the larger one of the configured rate sigma and the smoothed prediction errors per second;
+// a fix older than max_age is not extrapolated any longer;
+// times are given in s on any monotonic or wall clock, the class does not depend on ROS;
+class PositionEstimator {
+
+    public:
+
+        struct Estimate {
+
+            double  latitude;                   // [] = deg
+            double  longitude;                  // [] = deg
+            double  altitude;                   // [] = m
+            double  horizontal_variance;        // [] = m^2; east and north
+            double  vertical_variance;          // [] = m^2
+            double  age;                        // [] = s; time since the fix
+
+        };
+
+        // uere:        [] = m; user equivalent range error, scaled by the pdop of a fix;
+        // rate_sigma:  [] = m/s; minimum error of the rates;
+        // max_age:     [] = s; maximum extrapolation time;
+        PositionEstimator(double uere = 1.0, double rate_sigma = 0.1, double max_age = 1.0)
+            : uere_(uere), rate_sigma_(rate_sigma), max_age_(max_age) {
+
+            reset();
+
+        }
+
+        void reset() {
+
+            valid_              = false;
+            fix_time_           = 0.0;
+            rate_variance_      = rate_sigma_ * rate_sigma_;
+            smoothed_variance_  = rate_variance_;
+
+        }
+
+        bool valid() const {return valid_;}
+
+        // corrects the estimate with a new fix which refers to time;
+        // returns the distance between the prediction for time and the fix in m, or -1.0 without a prediction;
+        double correct(const Dgps::GpsData & fix, double time) {
+
+            const double deg_to_rad     = M_PI / 180.0;
+            const double earth_radius   = 6378137.0;    // [] = m; WGS84 semi-major axis
+            const double smoothing      = 0.1;          // weight of a new prediction error
+
+            double error = -1.0;
+            Estimate prediction;
+
+            if (predict(time, prediction)) {
+
+                double north = (fix.latitude_value - prediction.latitude) * deg_to_rad * earth_radius;
+                double east  = (fix.longitude_value - prediction.longitude) * deg_to_rad * earth_radius
+                             * std::cos(fix.latitude_value * deg_to_rad);
+                double up    = fix.altitude_value - prediction.altitude;
+
+                error = std::sqrt(north * north + east * east + up * up);
+
+                // smoothed squared prediction error per second of extrapolation;
+                if (prediction.age > 0.0) {
+
+                    double rate_error = error / prediction.age;
+                    smoothed_variance_ += smoothing * (rate_error * rate_error - smoothed_variance_);
+                    rate_variance_      = std::max(rate_sigma_ * rate_sigma_, smoothed_variance_);
+
+                }
+
+            }
+
+            else {
+
+                smoothed_variance_  = rate_sigma_ * rate_sigma_;
+
+            }
+
+            fix_                = fix;
+            fix_time_           = time;
+            valid_              = true;
+
+            return error;
+
+        }
+
+        // extrapolates the latest fix to time;
+        // returns false without a fix or if it is older than max_age;
+        bool predict(double time, Estimate & estimate) const {
+
+            const double rad_to_deg = 180.0 / M_PI;
+
+            if (!valid_)
+                return false;
+
+            // a time slightly before the fix (e.g. clock jitter) gets the fix itself;
+            double age = std::max(0.0, time - fix_time_);
+
+            if (age > max_age_)
+                return false;
+
+            estimate.latitude           = fix_.latitude_value   + fix_.latitude_rate  * age * rad_to_deg;
+            estimate.longitude          = fix_.longitude_value  + fix_.longitude_rate * age * rad_to_deg;
+            estimate.altitude           = fix_.altitude_value   + fix_.altitude_rate  * age;
+
+            double fix_sigma            = fix_.pdop * uere_;
+
+            estimate.horizontal_variance = fix_sigma * fix_sigma + rate_variance_ * age * age;
+            estimate.vertical_variance   = estimate.horizontal_variance;
+            estimate.age                 = age;
+
+            return true;
+
+        }
+
+        // the fix of the last correction;
+        const Dgps::GpsData & fix() const {return fix_;}
+
+    private:
+
+        double          uere_;
+        double          rate_sigma_;
+        double          max_age_;
+
+        bool            valid_;
+        Dgps::GpsData   fix_;
+        double          fix_time_;
+        double          rate_variance_;         // [] = m^2/s^2
+        double          smoothed_variance_;     // [] = m^2/s^2
+
+};
+
+#endif // POSITION_ESTIMATOR_H_
@@ -0,0 +1,210 @@
+/*!
+*****************************************************************
+* ReceiverEmulator.h
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_dgps
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description: The seneka_dgps package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* It implements a GNU/Linux driver for the Trimble BD982 GNSS Receiver Module as well as a ROS publisher node "DGPS", which acts as a wrapper for the driver.
+* The ROS node "DGPS" publishes GPS data gathered by the DGPS device driver.
+* This package might work with other hardware and can be used for other purposes, however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef RECEIVER_EMULATOR_H_
+#define RECEIVER_EMULATOR_H_
+
+/****************************************/
+/*************** includes ***************/
+/****************************************/
+
+#include <boost/thread.hpp>
+
+#include <deque>
+#include <string>
+#include <utility>
+
+/******************************************************/
+/*************** ReceiverEmulator class ***************/
+/******************************************************/
+
+// emulates a Trimble BD982 GNSS receiver on a pseudo-terminal, so that Dgps and the ROS node "DGPS"
+// can be tested and benchmarked without the device;
+// answers "ENQ" (05h) with "ACK" (06h) and "GETRAW" (56h) position record requests with a concise
+// "RAWDATA" (57h) position record; optionally sends position records on its own (streaming mode);
+// requests of other raw data types (up to 0Fh) are answered with a record of record_pages pages of filler data;
+// the position follows a straight line at constant velocity, so that the rates are consistent;
+// the GPS time of a record is the current time, sendTime() maps it to the time the record was written;
+// timing, noise and faults (NAK, bad checksum, split packets, missing replies, outages) are configurable;
+// see Trimble BD982 GNSS Receiver Manual, p. 65ff, p. 132 and p. 139f;
+class ReceiverEmulator {
+
+    public:
+
+        struct Config {
+
+            int     reply_delay;            // [] = ms; delay between request and reply;
+            int     reply_jitter;           // [] = ms; uniformly distributed additional delay;
+            int     baud_rate;              // [] = Bd; paces replies like a serial line, 0 sends at once;
+            double  stream_rate;            // [] = Hz; position records sent on its own, 0 disables streaming;
+            double  position_noise;         // [] = m; standard deviation of the position;
+            double  nak_probability;        // reply "NAK" (15h) instead of the record;
+            double  checksum_probability;   // reply a record with a wrong checksum;
+            double  split_probability;      // write the record in two parts with split_delay in between;
+            int     split_delay;            // [] = ms;
+            double  drop_probability;       // do not reply at all;
+            int     satellites;             // number of used satellites, 0..12;
+            int     record_pages;           // pages of records other than the position record, 1..15;
+
+            Config() :
+                reply_delay(5), reply_jitter(0), baud_rate(38400), stream_rate(0.0), position_noise(0.0),
+                nak_probability(0.0), checksum_probability(0.0), split_probability(0.0), split_delay(20),
+                drop_probability(0.0), satellites(8), record_pages(2) {}
+
+        };
+
+        struct Statistics {
+
+            unsigned long enquiries;        // "ENQ" (05h)
+            unsigned long requests;         // "GETRAW" (56h) position record requests
+            unsigned long invalid_requests; // packets with wrong checksum, type or data
+            unsigned long records;          // valid position records sent
+            unsigned long naks;
+            unsigned long bad_checksums;
+            unsigned long splits;
+            unsigned long drops;            // requests without reply, including outages
+
+        };
+
+        ReceiverEmulator(const Config & config = Config());
+        ~ReceiverEmulator();
+
+        // opens a pty pair and starts answering in an own thread;
+        // link: optional symlink to the slave device, e.g. a fixed port name for the node;
+        bool open(const std::string & link = "");
+
+        // stops the thread and closes the pty pair;
+        void close();
+
+        // slave device of the pty pair, e.g. /dev/pts/3;
+        const std::string & getDeviceName() const {return device_name;}
+
+        // configuration can be changed while the emulator is running;
+        void    setConfig(const Config & config);
+        Config  getConfig();
+
+        // receiver does neither reply nor stream for duration ms from now on;
+        void interrupt(int duration);
+
+        Statistics getStatistics();
+
+        // time at which the record with gps_msec_of_week has been written completely;
+        // returns false for an unknown or too old record;
+        bool sendTime(long gps_msec_of_week, boost::system_time & time);
+
+        // epoch (GPS time as UTC) of the record with gps_msec_of_week and the time it has been written completely;
+        // returns false for an unknown or too old record;
+        bool sendTime(long gps_msec_of_week, boost::system_time & epoch_time, boost::system_time & time);
+
+    private:
+
+        // thread: reads requests, replies and streams;
+        void run();
+
+        // handles a received byte; collects packets and answers them;
+        void receive(unsigned char byte);
+        void handleRequest();
+
+        // builds and writes a position record with the configured faults;
+        void sendRecord(bool requested);
+
+        // builds and writes a record of another type, split into record_pages pages;
+        void sendPages(unsigned char record_type);
+
+        // writes data like a serial line with baud_rate would;
+        bool write(const unsigned char * data, size_t size, int baud_rate);
+
+        // random numbers of a fixed seed, so that fault patterns are reproducible;
+        double uniform();
+        double gaussian();
+
+        bool outage();
+
+        int                 master;
+        int                 slave;
+        std::string         device_name;
+        std::string         link_name;
+
+        boost::thread       thread;
+        boost::mutex        mutex;              // guards config, statistics, send_times, outage_end and running
+        bool                running;
+
+        Config              config;
+        Statistics          statistics;
+        boost::system_time  outage_end;
+        boost::system_time  start_time;
+
+        struct SentRecord {
+
+            long                msec_of_week;   // GPS time
+            boost::system_time  epoch_time;     // GPS time as UTC
+            boost::system_time  send_time;      // time when written
+
+        };
+
+        // recently sent records;
+        std::deque<SentRecord> send_times;
+        long                last_msec_of_week;
+        unsigned char       reply_number;       // of the multi-page records
+
+        // incoming packet;
+        unsigned char       packet[4 + 255 + 2];
+        size_t              packet_size;
+
+        unsigned int        seed;
+
+};
+
+#endif // RECEIVER_EMULATOR_H_
@@ -0,0 +1,199 @@
+/*!
+*****************************************************************
+* RecordAssembler.h
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_dgps
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description: The seneka_dgps package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* It implements a GNU/Linux driver for the Trimble BD982 GNSS Receiver Module as well as a ROS publisher node "DGPS", which acts as a wrapper for the driver.
+* The ROS node "DGPS" publishes GPS data gathered by the DGPS device driver.
+* This package might work with other hardware and can be used for other purposes, however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef RECORD_ASSEMBLER_H_
+#define RECORD_ASSEMBLER_H_
+
+/****************************************/
+/*************** includes ***************/
+/****************************************/
+
+#include <stddef.h>
+#include <vector>
+
+/*****************************************************/
+/*************** RecordAssembler class ***************/
+/*****************************************************/
+
+// reassembles raw data records which the receiver splits into several "RAWDATA" (57h) packets;
+// data part of a packet: record type, page counter, reply number, record interpretation flags, record data;
+// page counter: page number in the high nibble and number of pages in the low nibble, e.g. 11h = page 1 of 1;
+// the pages of a record have the same reply number and are sent in order, their data is concatenated;
+// a record is assembled per record type, so records of different types may be interleaved;
+// a missing or repeated page drops the incomplete record;
+// see Trimble BD982 GNSS Receiver Manual, p. 132ff;
+class RecordAssembler {
+
+    public:
+
+        // record types are stored up to this value;
+        static const unsigned int max_record_type = 15;
+
+        struct Record {
+
+            unsigned char               record_type;
+            unsigned char               reply_number;
+            unsigned char               record_interpretation_flags;
+            std::vector<unsigned char>  data;
+
+        };
+
+        struct Statistics {
+
+            unsigned long records;
+            unsigned long pages;
+            unsigned long dropped_records;      // incomplete records (missing pages)
+            unsigned long unknown_types;        // pages of records above max_record_type
+
+        };
+
+        RecordAssembler() {
+
+            reset();
+
+        }
+
+        void reset() {
+
+            for (unsigned int i = 0; i <= max_record_type; i++)
+                next_page_[i] = 0;
+
+            statistics_.records         = 0;
+            statistics_.pages           = 0;
+            statistics_.dropped_records = 0;
+            statistics_.unknown_types   = 0;
+
+            completed_                  = 0;
+
+        }
+
+        // packet: complete "RAWDATA" (57h) packet, stx to etx, validated by PacketFramer;
+        // returns true if the packet completes a record, record() holds it until the next call;
+        bool push(const unsigned char * packet, size_t size) {
+
+            // stx, status, packet type, length, 4 bytes record header, checksum, etx;
+            if (size < 4 + 4 + 2 || packet[3] < 4)
+                return false;
+
+            unsigned char record_type   = packet[4];
+            unsigned int  page          = packet[5] >> 4;
+            unsigned int  pages         = packet[5] & 0x0f;
+
+            if (record_type > max_record_type) {
+                statistics_.unknown_types++;
+                return false;
+            }
+
+            statistics_.pages++;
+
+            Record & record = records_[record_type];
+            unsigned int & next_page = next_page_[record_type];
+
+            // the first page starts a new record, an incomplete one is dropped;
+            if (page == 1) {
+
+                if (next_page != 0)
+                    statistics_.dropped_records++;
+
+                record.record_type                  = record_type;
+                record.reply_number                 = packet[6];
+                record.record_interpretation_flags  = packet[7];
+                record.data.clear();
+
+                next_page = 1;
+
+            }
+
+            // a page which does not continue the record drops it;
+            if (next_page == 0 || page != next_page || pages == 0 || page > pages || packet[6] != record.reply_number) {
+
+                if (next_page != 0)
+                    statistics_.dropped_records++;
+
+                next_page = 0;
+
+                return false;
+
+            }
+
+            record.data.insert(record.data.end(), packet + 8, packet + 4 + packet[3]);
+
+            if (page < pages) {
+                next_page++;
+                return false;
+            }
+
+            next_page = 0;
+            completed_ = record_type;
+            statistics_.records++;
+
+            return true;
+
+        }
+
+        const Record & record() const {return records_[completed_];}
+
+        const Statistics & statistics() const {return statistics_;}
+
+    private:
+
+        Record          records_[max_record_type + 1];
+        unsigned int    next_page_[max_record_type + 1];    // 0 if no record is being assembled
+        unsigned int    completed_;
+        Statistics      statistics_;
+
+};
+
+#endif // RECORD_ASSEMBLER_H_
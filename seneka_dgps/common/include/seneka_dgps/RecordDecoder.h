@@ -0,0 +1,192 @@
+/*!
+*****************************************************************
+* RecordDecoder.h
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_dgps
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description: The seneka_dgps package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* It implements a GNU/Linux driver for the Trimble BD982 GNSS Receiver Module as well as a ROS publisher node "DGPS", which acts as a wrapper for the driver.
+* The ROS node "DGPS" publishes GPS data gathered by the DGPS device driver.
+* This package might work with other hardware and can be used for other purposes, however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef RECORD_DECODER_H_
+#define RECORD_DECODER_H_
+
+/****************************************/
+/*************** includes ***************/
+/****************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <cstring>
+
+/***************************************************/
+/*************** RecordDecoder class ***************/
+/***************************************************/
+
+// decodes the fields of Trimble records straight from the packet buffer;
+// all numbers are transmitted in motorola format (big-endian, IEEE 754 for FLOAT and DOUBLE),
+// see Trimble BD982 GNSS Receiver Manual, p. 66ff;
+// the layout of a record is defined at compile time by its fields (see PositionRecord below),
+// so decoding a field is a single load and byte swap without any temporary buffer or heap allocation;
+class RecordDecoder {
+
+    public:
+
+        // field of type T at a fixed byte offset of a record;
+        template <typename T, size_t OFFSET>
+        struct Field {
+
+            typedef T type;
+
+            static const size_t offset = OFFSET;
+            static const size_t end    = OFFSET + sizeof(T);
+
+        };
+
+        // returns the value of field F of the record starting at record;
+        // the caller has to make sure that the record holds at least F::end bytes;
+        template <typename F>
+        static typename F::type get(const unsigned char * record) {
+
+            typename F::type value;
+            decode(record + F::offset, value);
+            return value;
+
+        }
+
+        // returns the value of field F of the i-th element of a repeated block
+        // of element_size bytes, which starts at F::offset;
+        template <typename F>
+        static typename F::type get(const unsigned char * record, size_t element_size, size_t i) {
+
+            typename F::type value;
+            decode(record + F::offset + element_size * i, value);
+            return value;
+
+        }
+
+        // big-endian decoding of the supported data types;
+        static void decode(const unsigned char * bytes, uint8_t & value)  { value = bytes[0]; }
+        static void decode(const unsigned char * bytes, int8_t & value)   { value = (int8_t) bytes[0]; }
+        static void decode(const unsigned char * bytes, char & value)     { value = (char) bytes[0]; }
+        static void decode(const unsigned char * bytes, uint16_t & value) { value = load16(bytes); }
+        static void decode(const unsigned char * bytes, int16_t & value)  { value = (int16_t) load16(bytes); }
+        static void decode(const unsigned char * bytes, uint32_t & value) { value = load32(bytes); }
+        static void decode(const unsigned char * bytes, int32_t & value)  { value = (int32_t) load32(bytes); }
+
+        static void decode(const unsigned char * bytes, float & value) {
+
+            uint32_t bits = load32(bytes);
+            std::memcpy(&value, &bits, sizeof(value));
+
+        }
+
+        static void decode(const unsigned char * bytes, double & value) {
+
+            uint64_t bits = load64(bytes);
+            std::memcpy(&value, &bits, sizeof(value));
+
+        }
+
+    private:
+
+        // shifts of single bytes are compiled to a load and a byte swap instruction;
+        static uint16_t load16(const unsigned char * bytes) {
+
+            return (uint16_t) ((bytes[0] << 8) | bytes[1]);
+
+        }
+
+        static uint32_t load32(const unsigned char * bytes) {
+
+            return ((uint32_t) bytes[0] << 24) | ((uint32_t) bytes[1] << 16) |
+                   ((uint32_t) bytes[2] <<  8) |  (uint32_t) bytes[3];
+
+        }
+
+        static uint64_t load64(const unsigned char * bytes) {
+
+            return ((uint64_t) load32(bytes) << 32) | load32(bytes + 4);
+
+        }
+
+};
+
+/**********************************************/
+/*************** record layouts ***************/
+/**********************************************/
+
+// RAWDATA (57h) PACKET - POSITION RECORD (record type 01h) - DATA PART;
+// byte offsets relative to the first byte after the record interpretation flags;
+// see Trimble BD982 GNSS Receiver manual, p. 139f;
+struct PositionRecord {
+
+    typedef RecordDecoder::Field<double,   0>  Latitude;            // [] = semi-circles
+    typedef RecordDecoder::Field<double,   8>  Longitude;           // [] = semi-circles
+    typedef RecordDecoder::Field<double,  16>  Altitude;            // [] = m
+    typedef RecordDecoder::Field<double,  24>  ClockOffset;         // [] = m
+    typedef RecordDecoder::Field<double,  32>  FrequencyOffset;     // [] = Hz
+    typedef RecordDecoder::Field<double,  40>  Pdop;
+    typedef RecordDecoder::Field<double,  48>  LatitudeRate;        // [] = rad/s
+    typedef RecordDecoder::Field<double,  56>  LongitudeRate;       // [] = rad/s
+    typedef RecordDecoder::Field<double,  64>  AltitudeRate;        // [] = m/s
+    typedef RecordDecoder::Field<uint32_t, 72> GpsMsecOfWeek;       // [] = ms
+    typedef RecordDecoder::Field<char,    76>  PositionFlags;
+    typedef RecordDecoder::Field<uint8_t, 77>  NumberOfSVs;
+
+    // one block of sv_size bytes per satellite;
+    typedef RecordDecoder::Field<char,    78>  ChannelNumber;
+    typedef RecordDecoder::Field<char,    79>  Prn;
+
+    // size of the fixed part and of a satellite block;
+    static const size_t size    = 78;
+    static const size_t sv_size = 2;
+
+};
+
+#endif // RECORD_DECODER_H_
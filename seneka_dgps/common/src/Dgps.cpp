@@ -57,88 +57,65 @@
 ****************************************************************/
 
 #include <seneka_dgps/Dgps.h>
-#include <boost/optional.hpp>
-#include <boost/asio/deadline_timer.hpp>
+#include <seneka_dgps/RecordDecoder.h>
+#include <algorithm>
+#include <cstring>
 #include <boost/bind.hpp> 
-#include <boost/asio.hpp>
 #include <boost/thread.hpp>
 
-void set_result1(boost::optional<boost::system::error_code>* a, boost::system::error_code b) 
-{ 
-	a->reset(b);
-} 
-void set_result2(boost::optional<boost::system::error_code>* a, boost::system::error_code b, size_t *bytes_transferred, size_t _bytes_transferred) 
-{ 
-	a->reset(b);
-	*bytes_transferred = _bytes_transferred;
-} 
-
-
-template <typename MutableBufferSequence> 
-int read_with_timeout(boost::asio::serial_port& sock, 
-  const MutableBufferSequence& buffers) 
-{ 
-	boost::optional<boost::system::error_code> timer_result; 
-	boost::asio::deadline_timer timer(sock.io_service()); 
-	timer.expires_from_now(boost::posix_time::milliseconds(1000)); 
-	timer.async_wait(boost::bind(set_result1, &timer_result, _1)); 
-
-
-	size_t bytes_to_transfer = 0;
-	boost::optional<boost::system::error_code> read_result; 
-	boost::asio::async_read(sock, buffers, 
-		boost::bind(set_result2, &read_result, _1, &bytes_to_transfer, boost::asio::placeholders::bytes_transferred)); 
-
-	sock.io_service().reset(); 
-	while (sock.io_service().run_one()) 
-	{ 
-	  if (read_result) 
-		timer.cancel(); 
-	  else if (timer_result) 
-		sock.cancel(); 
-	} 
-
-
-	if (*read_result && !(*read_result==boost::asio::error::operation_aborted && bytes_to_transfer>0) ) {
-		std::cout<<"error code: "<<(*read_result)<<std::endl;
-	  return 0; //throw boost::system::system_error(*read_result);
-	  }
-	  
-	return bytes_to_transfer;
-} 
+// timeout for the response to a request in ms;
+#define RESPONSE_TIMEOUT ( 1000 )
+
+// idle time of the serial link in ms, after which an incomplete packet is rejected;
+// the receiver transmits its packets without gaps, USB serial adapters deliver them in chunks up to 16 ms apart;
+#define IDLE_GAP ( 50 )
 
 /*********************************************************/
 /*************** Dgps class implementation ***************/
 /*********************************************************/
 
 // constructor
-Dgps::Dgps() : m_SerialIO(io_service_) {
-	boost::thread t(boost::bind(&boost::asio::io_service::run, &io_service_));
+Dgps::Dgps() {
+
+    position_pending    = false;
+    control_response    = PacketFramer::NONE;
+    nak_count           = 0;
+    read_failed         = false;
+    reported_resyncs    = 0;
+    request_resyncs     = 0;
+    reported_dropped_records = 0;
+    framer_statistics   = framer.statistics();
+    assembler_statistics = assembler.statistics();
+    last_read_time      = boost::get_system_time();
+    arrival_time        = last_read_time;
+    overwritten_packets = 0;
+
+    for (unsigned int i = 0; i <= RecordAssembler::max_record_type; i++) {
+        record_counts[i]    = 0;
+        awaited_counts[i]   = 0;
+    }
+
+    // position record only;
+    record_types.push_back(0x01);
+
 }
 
 // destructor
-Dgps::~Dgps() {}
+Dgps::~Dgps() {
+
+    close();
+
+}
 
 /**************************************************/
 /**************************************************/
 /**************************************************/
 
 // takes diagnostic statements and stores them in diagnostic_array;
-// if diagnostic_array holds more than 100 elements, the oldest stored element will get erased;
+// if diagnostic_array holds 100 elements, the oldest stored element gets overwritten;
 void Dgps::transmitStatement(DiagnosticFlag flag) {
 
-    diagnostic_statement.diagnostic_message = msg.str();
-    diagnostic_statement.diagnostic_flag    = flag;
-
-    if (diagnostic_array.size() >= 100) {
-
-        std::vector<DiagnosticStatement>::iterator it = diagnostic_array.begin();
-
-        diagnostic_array.erase(it);
-    
-    }
-
-    diagnostic_array.push_back(diagnostic_statement);
+    diagnostic_array.push(flag, msg.str());
 
     // this expression clears the stringstream instance after each transmit process;
     // if it doesn't get cleared, every new diagnostic statement will get attached
@@ -154,11 +131,6 @@ void Dgps::transmitStatement(DiagnosticFlag flag) {
 // establishes serial connection
 bool Dgps::open(const char * pcPort, int iBaudRate) {
 
-    //now comes a hack...
-    char buf[256];
-    sprintf(buf, "stty -F %s ispeed %d ospeed %d", pcPort, iBaudRate, iBaudRate);
-    system(buf);
-
     msg << "Establishing serial connection to GPS device...";
     transmitStatement(INFO);
 
@@ -168,9 +140,24 @@ bool Dgps::open(const char * pcPort, int iBaudRate) {
     msg << "Baud rate: " << iBaudRate;
     transmitStatement(INFO);
 
-    // open port;
+    // a connection which is already open is reopened;
+    close();
+
+    // the reactor thread feeds all received bytes into the framer;
+    framer.reset();
+    assembler.reset();
+    clearResponses();
+    read_failed = false;
+    reported_resyncs = 0;
+    reported_dropped_records = 0;
+    overwritten_packets = 0;
+
+    // open and configure port (raw mode, 8N1, low latency, exclusive access), reading starts immediately;
     boost::system::error_code ec;
-    m_SerialIO.open(pcPort, ec);
+    serial_port.open(pcPort, iBaudRate,
+                     boost::bind(&Dgps::handleReceive, this, _1, _2),
+                     boost::bind(&Dgps::handleReadError, this, _1),
+                     ec);
 
     if (ec) {
         msg << "Failed to establish connection. Device is not available on given port. "<<ec;
@@ -183,19 +170,187 @@ bool Dgps::open(const char * pcPort, int iBaudRate) {
         msg << "Connection established.";
         transmitStatement(INFO);
 
+        if (serial_port.lowLatency())
+            msg << "Low latency mode enabled.";
+        else
+            msg << "Low latency mode is not supported by the serial driver.";
+        transmitStatement(INFO);
+
         return true;
     }
-    
-    m_SerialIO.set_option(boost::asio::serial_port_base::baud_rate(iBaudRate), ec);
-    if(ec) printf("failed apply settings (%s, %d)", ec.category().name(), (int)ec.value());
-	m_SerialIO.set_option(boost::asio::serial_port_base::character_size(8), ec);
-    if(ec) printf("failed apply settings (%s, %d)", ec.category().name(), (int)ec.value());
-	m_SerialIO.set_option(boost::asio::serial_port_base::stop_bits(boost::asio::serial_port_base::stop_bits::one), ec);
-    if(ec) printf("failed apply settings (%s, %d)", ec.category().name(), (int)ec.value());
-	m_SerialIO.set_option(boost::asio::serial_port_base::parity(boost::asio::serial_port_base::parity::none), ec);
-    if(ec) printf("failed apply settings (%s, %d)", ec.category().name(), (int)ec.value());
-	m_SerialIO.set_option(boost::asio::serial_port_base::flow_control(boost::asio::serial_port_base::flow_control::none), ec);
-    if(ec) printf("failed apply settings (%s, %d)", ec.category().name(), (int)ec.value());
+}
+
+/**************************************************/
+/**************************************************/
+/**************************************************/
+
+// stops reading and closes the serial connection;
+void Dgps::close() {
+
+    serial_port.close();
+
+}
+
+/**************************************************/
+/**************************************************/
+/**************************************************/
+
+// called by the reactor thread;
+// complete packets are taken out of the framer as soon as their last byte arrives;
+void Dgps::handleReceive(const unsigned char * data, size_t size) {
+
+    {
+        boost::mutex::scoped_lock lock(response_mutex);
+
+        framer.push(data, size);
+        last_read_time = boost::get_system_time();
+
+        processFrames();
+    }
+
+    response_condition.notify_all();
+
+}
+
+// called by the reactor thread, e.g. if the device has been unplugged;
+void Dgps::handleReadError(const boost::system::error_code & ec) {
+
+    {
+        boost::mutex::scoped_lock lock(response_mutex);
+        read_failed         = true;
+        read_error_message  = ec.message();
+    }
+
+    response_condition.notify_all();
+
+}
+
+void Dgps::processFrames() {
+
+    PacketFramer::Event event;
+
+    while ((event = framer.next()) != PacketFramer::NONE) {
+
+        // other packet types (e.g. unrequested packets) are skipped;
+        if (event == PacketFramer::PACKET && framer.packet()[2] == 0x57) {
+
+            // pages of a multi-page record are collected until the record is complete;
+            if (!assembler.push(framer.packet(), framer.packetSize()))
+                continue;
+
+            const RecordAssembler::Record & record = assembler.record();
+
+            // the slot of the writer keeps the capacity of its data vector;
+            RawRecord & cached                  = record_cache[record.record_type].back();
+            cached.record_type                  = record.record_type;
+            cached.record_interpretation_flags  = record.record_interpretation_flags;
+            cached.data.assign(record.data.begin(), record.data.end());
+            cached.arrival_time                 = last_read_time;
+
+            record_cache[record.record_type].publish();
+            record_counts[record.record_type]++;
+
+            if (record.record_type == 0x01) {
+
+                // a streamed position record which has not been taken yet is replaced by the newer one;
+                if (position_pending)
+                    overwritten_packets++;
+
+                position_pending = true;
+
+            }
+
+        }
+
+        else if (event == PacketFramer::ACK || event == PacketFramer::NAK) {
+
+            control_response = event;
+
+            if (event == PacketFramer::NAK)
+                nak_count++;
+
+        }
+
+    }
+
+    framer_statistics       = framer.statistics();
+    assembler_statistics    = assembler.statistics();
+
+}
+
+void Dgps::clearResponses() {
+
+    boost::mutex::scoped_lock lock(response_mutex);
+
+    position_pending    = false;
+    control_response    = PacketFramer::NONE;
+    nak_count           = 0;
+    awaited_types.clear();
+
+}
+
+bool Dgps::responseComplete(Response response) {
+
+    switch (response) {
+
+        case CONTROL:
+
+            return control_response != PacketFramer::NONE;
+
+        case POSITION:
+
+            return position_pending || control_response == PacketFramer::NAK;
+
+        case RECORDS: {
+
+            // the receiver answers every request either with its record or with "NAK";
+            unsigned long missing = 0;
+
+            for (size_t i = 0; i < awaited_types.size(); i++)
+                if (record_counts[awaited_types[i]] == awaited_counts[awaited_types[i]])
+                    missing++;
+
+            return missing <= nak_count;
+
+        }
+
+    }
+
+    return false;
+
+}
+
+bool Dgps::waitForResponse(Response response, int timeout) {
+
+    boost::system_time deadline = boost::get_system_time() + boost::posix_time::milliseconds(timeout);
+
+    boost::mutex::scoped_lock lock(response_mutex);
+
+    while (!read_failed && !responseComplete(response)) {
+
+        boost::system_time now = boost::get_system_time();
+        if (now >= deadline)
+            break;
+
+        // an incomplete packet, which is not continued, is a garbage stx and costs a resync only;
+        if (framer.pending() && now - last_read_time >= boost::posix_time::milliseconds(IDLE_GAP)) {
+            framer.dropCandidate();
+            processFrames();
+            continue;
+        }
+
+        // a reply, which was rejected, is not repeated by the receiver; if the link stays quiet,
+        // the request is given up instead of waiting for the timeout and repeated with the next cycle;
+        if (response == RECORDS && framer_statistics.resyncs > request_resyncs
+                && now - last_read_time >= boost::posix_time::milliseconds(IDLE_GAP))
+            break;
+
+        response_condition.timed_wait(lock, std::min(deadline, now + boost::posix_time::milliseconds(IDLE_GAP)));
+
+    }
+
+    return responseComplete(response);
+
 }
 
 /**************************************************/
@@ -214,13 +369,16 @@ bool Dgps::checkConnection() {
     /**************************************************/
     /**************************************************/
 
+    // older responses must not be taken as the answer;
+    clearResponses();
+
     // test command "ENQ" (05h)
     char message[]      = {0x05};
     int message_size    = sizeof(message) / sizeof(message[0]);
 
     int bytes_sent  = 0;
     boost::system::error_code ec;
-    bytes_sent      = m_SerialIO.write_some(boost::asio::buffer(message, message_size), ec); // function returns number of transmitted bytes;
+    bytes_sent      = serial_port.write(message, message_size, ec); // function returns number of transmitted bytes;
 
     if (!(bytes_sent > 0)) {
         msg << "Could not send test command.";
@@ -234,9 +392,21 @@ bool Dgps::checkConnection() {
     /**************************************************/
     /**************************************************/
 
-	unsigned char result[1];
-	const int num = read_with_timeout(m_SerialIO, boost::asio::buffer(result,sizeof(result)));
-	
+    // the response is received by the reactor thread;
+    waitForResponse(CONTROL, RESPONSE_TIMEOUT);
+
+    unsigned char result[1];
+    int num = 0;
+
+    {
+        boost::mutex::scoped_lock lock(response_mutex);
+
+        if (control_response != PacketFramer::NONE) {
+            result[0] = (control_response == PacketFramer::ACK) ? 0x06 : 0x15;
+            num = 1;
+        }
+    }
+
     /**************************************************/
     /**************************************************/
     /**************************************************/
@@ -302,35 +472,55 @@ bool Dgps::getDgpsData() {
     /**************************************************/
     /**************************************************/
 
-    // generation of request command packet "GETRAW" (56h);
-    // expected reply packet is "RAWDATA" (57h); 
+    // generation of request command packets "GETRAW" (56h), one per record type;
+    // the requests are sent back-to-back, the receiver answers them in order;
+    // expected reply packets are "RAWDATA" (57h), one or more pages per record;
     // see Trimble BD982 GNSS Receiver Manual, p. 73/132;
 
     unsigned char stx           = 0x02; // head
     unsigned char status        = 0x00;
     unsigned char packet_type   = 0x56; // this command packet is of type "GETRAW" (56h);
     unsigned char length        = 0x03; // length of data part;
-    unsigned char data_type     = 0x01; // raw data type:   position record --> type    = 00000001 (binary);
     unsigned char flags         = 0x01; // raw data format: concise         --> flags   = 00000001 (binary);
     unsigned char reserved      = 0x00; // tail
-    unsigned char checksum;
     unsigned char etx           = 0x03;
 
-    checksum = (status + packet_type + length + data_type + flags + reserved);
+    std::vector<char> message;
+    message.reserve(9 * record_types.size());
 
-    char message[]      = {stx, status, packet_type, length, data_type, flags, reserved, checksum, etx};
-    int message_size    = sizeof(message) / sizeof(message[0]);
+    for (size_t i = 0; i < record_types.size(); i++) {
+
+        unsigned char data_type = record_types[i];  // raw data type, e.g. position record --> type = 00000001 (binary);
+        unsigned char checksum  = (status + packet_type + length + data_type + flags + reserved);
+
+        char request[] = {stx, status, packet_type, length, data_type, flags, reserved, checksum, etx};
+        message.insert(message.end(), request, request + sizeof(request));
+
+    }
 
     /**************************************************/
     /**************************************************/
     /**************************************************/
 
-    // transmission of request command
+    // older responses must not be taken as the answer;
+    clearResponses();
+
+    {
+        boost::mutex::scoped_lock lock(response_mutex);
+
+        awaited_types   = record_types;
+        request_resyncs = framer_statistics.resyncs;
+
+        for (size_t i = 0; i < awaited_types.size(); i++)
+            awaited_counts[awaited_types[i]] = record_counts[awaited_types[i]];
+    }
+
+    // transmission of request commands
     int bytes_sent  = 0;
     boost::system::error_code ec;
-    bytes_sent      = m_SerialIO.write_some(boost::asio::buffer(message, message_size), ec); // function returns number of transmitted bytes;
+    bytes_sent      = serial_port.write(&message[0], message.size(), ec); // function returns number of transmitted bytes;
 
-    if (bytes_sent != message_size) {
+    if (bytes_sent != (int) message.size()) {
         msg << "Failed to transmit request command.";
         transmitStatement(WARNING);
     }
@@ -339,149 +529,192 @@ bool Dgps::getDgpsData() {
     /**************************************************/
     /**************************************************/
 
-    // buffer for expected reply packet;
-    // the size of the buffer is equal to the maximum size a "RAWDATA" (57h) reply packet of type 57h position record can get;
-    // maximum_size = 8 bytes + 78 bytes + 2 * N bytes + 2 bytes = 112  bytes; (where N, the number of used sattelites, is 12);
-    // minimum_size = 8 bytes + 78 bytes + 2 * N bytes + 2 bytes = 88   bytes; (where N, the number of used sattelites, is 0);
-    // see Trimble BD982 GNSS Receiver Manual, p. 139;
-    unsigned char buffer[112+16] = {0}; // why 112+16? --> see debugBuffer() function comment;
-    
-    // reading response from serial port;
-	const int bytes_received = read_with_timeout(m_SerialIO, boost::asio::buffer(buffer,sizeof(buffer)));
-	
-    // see comment at debugBuffer() function;
-    int bytes_received_debugged = bytes_received;// - 16;
-    //std::vector<unsigned char> debugged_buffer = debugBuffer(buffer);
-    unsigned char *debugged_buffer = buffer;
+    // all replies are received, reassembled and cached by the reactor thread;
+    waitForResponse(RECORDS, RESPONSE_TIMEOUT);
 
-    /**************************************************/
-    /**************************************************/
-    /**************************************************/
+    for (size_t i = 0; i < record_types.size(); i++) {
+
+        if (record_types[i] == 0x01)
+            continue;
+
+        bool received;
+
+        {
+            boost::mutex::scoped_lock lock(response_mutex);
+            received = record_counts[record_types[i]] != awaited_counts[record_types[i]];
+        }
+
+        if (!received) {
+
+            msg << "No reply for record type " << (int) record_types[i] << ".";
+            transmitStatement(WARNING);
 
-    #ifndef NDEBUG
+        }
 
-    // this debug output lists reply packet from receiver module after requesting a position record with "GETRAW" (56h) command;
-    // there are three columns:
-    // first column:    originally received data frame buffer[] from begin to end,
-    // second column:   originally received data frame buffer[] omitting the first 16 bytes,
-    // third column:    resulting debugged data frame debugged_buffer[] (must be the same as buffer[] in column 2);
+    }
 
-    std::cout << endl << endl << "\t\t\t------------------------------" << endl << endl;
+    // the position record has been received already or is missing;
+    return receiveDgpsData(0);
 
-    std::cout << "bytes_received:\t\t" << bytes_received << endl;
-    std::cout << "bytes_received_debugged:\t" << bytes_received_debugged << endl;
+}
 
+/*******************************************************/
+/*******************************************************/
+/*******************************************************/
 
-    int k = 16;
+void Dgps::setRecordTypes(const std::vector<unsigned char> & types) {
 
-    for (int i = 0; i < (112+16); i++) {
+    record_types.clear();
 
-        std::cout << "\nbuffer[" << i << "]:\t";
-        printf("%x", buffer[i]);
+    for (size_t i = 0; i < types.size(); i++) {
 
-        if (!(i >= 112)) {
+        if (types[i] > RecordAssembler::max_record_type) {
 
-            std::cout << "\tbuffer[" << k << "]:\t";
-            printf("%x", buffer[k]);
+            msg << "Record type " << (int) types[i] << " is not supported.";
+            transmitStatement(WARNING);
 
-            std::cout << "\tdebugged_buffer[" << i <<"]:\t";
-            printf("%x", debugged_buffer[i]);
+        }
+
+        else if (std::find(record_types.begin(), record_types.end(), types[i]) == record_types.end()) {
+
+            record_types.push_back(types[i]);
 
         }
 
-        k++;
-        
     }
 
-    std::cout << endl << endl << "\t\t\t------------------------------" << endl << endl;
+    // the position record is always requested, getDgpsData() serves its data;
+    if (std::find(record_types.begin(), record_types.end(), 0x01) == record_types.end()) {
 
-    #endif
+        if (!types.empty()) {
+            msg << "Position record (1) is not among the record types, requesting it as well.";
+            transmitStatement(WARNING);
+        }
 
-    /**************************************************/
-    /**************************************************/
-    /**************************************************/
+        record_types.insert(record_types.begin(), 0x01);
 
-    // raw analysis of received data;
+    }
 
-    // checking if there has been a response at all;
-    if (!(bytes_received_debugged > 0)) {
+}
 
-        msg << "Device does not respond.";
-        transmitStatement(ERROR);
+bool Dgps::getRecord(unsigned char record_type, RawRecord & record) {
 
+    if (record_type > RecordAssembler::max_record_type)
         return false;
 
-    }
+    LatestValue<RawRecord> & cache = record_cache[record_type];
 
-    // checking for possible "NAK" (15h) reply packet;
-    else if (!(debugged_buffer[0] != 15)) {
-
-        msg << "Response packet is \"NAK\" (15h). Device cannot fullfill request.";
-        transmitStatement(WARNING);
+    cache.update();
 
+    if (!cache.valid())
         return false;
 
-    }
+    record = cache.front();
 
-    // checking for legal packet size;
-    else if (!(88 >= bytes_received_debugged <= 112)) {
+    return true;
 
-        msg << "Received packet has wrong size.";
-        transmitStatement(WARNING);
+}
 
-        return false;
+/*******************************************************/
+/*******************************************************/
+/*******************************************************/
 
-    }
+bool Dgps::receiveDgpsData(int timeout) {
 
-    // checking for packet head (stx);
-    else if (debugged_buffer[0] != 0x02) {
+    /**************************************************/
+    /**************************************************/
+    /**************************************************/
 
-        msg << "First byte of received packet is not stx (0x02).";
-        transmitStatement(WARNING);
+    // the reply packets are received and framed by the reactor thread (see PacketFramer.h);
+    // stx, length, checksum and etx have already been validated, packets of other types are skipped;
+    // the pages of a record have been reassembled and the record has been stored in the record cache;
+    // position record size = 78 bytes + 2 * N bytes; (where N, the number of used sattelites, is up to 12);
+    // see Trimble BD982 GNSS Receiver Manual, p. 139;
+    bool position_received = false;
+    bool nak_received = false;
+    bool read_error = false;
+    std::string read_error_message_copy;
+    PacketFramer::Statistics framer_stats;
+    RecordAssembler::Statistics assembler_stats;
+
+    waitForResponse(POSITION, timeout);
+
+    {
+        boost::mutex::scoped_lock lock(response_mutex);
+
+        // the record is consumed, the next call waits for a new one;
+        position_received = position_pending;
+        position_pending = false;
+
+        nak_received = (control_response == PacketFramer::NAK);
+        read_error = read_failed;
+        read_error_message_copy = read_error_message;
+        framer_stats = framer_statistics;
+        assembler_stats = assembler_statistics;
+
+        // a "NAK" is reported once;
+        if (nak_received)
+            control_response = PacketFramer::NONE;
+    }
 
-        return false;
+    // the latest position record; a newer one than the awaited one may have arrived meanwhile;
+    LatestValue<RawRecord> & cache = record_cache[0x01];
 
+    if (position_received) {
+        cache.update();
+        arrival_time = cache.front().arrival_time;
     }
 
-    // checking for packet tail (etx)
-    else if (debugged_buffer[bytes_received_debugged-1] != 0x03) {
+    // malformed bytes on the serial link;
+    if (framer_stats.resyncs > reported_resyncs) {
 
-        msg << "Last byte of received packet is not etx (0x03).";
+        msg << "Dropped " << (framer_stats.resyncs - reported_resyncs) << " malformed packets, "
+            << framer_stats.discarded_bytes << " bytes discarded since connection establishment.";
         transmitStatement(WARNING);
 
-        return false;
+        reported_resyncs = framer_stats.resyncs;
 
     }
 
-    // checking for packet type;
-    // must be "RAWDATA" (57h);
-    else if (debugged_buffer[2] != 0x57) {
+    // records with missing pages;
+    if (assembler_stats.dropped_records > reported_dropped_records) {
 
-        msg << "Received packet has wrong type.";
+        msg << "Dropped " << (assembler_stats.dropped_records - reported_dropped_records) << " incomplete multi-page records.";
         transmitStatement(WARNING);
 
-        return false;
+        reported_dropped_records = assembler_stats.dropped_records;
 
     }
 
-    // checking for record type;
-    // must be "Position Data" (01h);
-    else if (debugged_buffer[4] != 0x01) {
+    /**************************************************/
+    /**************************************************/
+    /**************************************************/
+
+    // raw analysis of received data;
+
+    // checking for a failure of the serial connection;
+    if (read_error) {
 
-        msg << "Received packet has wrong record type.";
-        transmitStatement(WARNING);
+        msg << "Reading from serial port failed: " << read_error_message_copy;
+        transmitStatement(ERROR);
 
         return false;
 
     }
 
-    // checking pager counter;
-    // must be 11h for position records;
-    // 11 hex = 00010001 binary --> means page 01 of 01;
-    else if (debugged_buffer[5] != 0x11) {
+    // checking if there has been a position record at all;
+    // it may be missing because of a "NAK" (15h) reply;
+    else if (!position_received) {
 
-        msg << "Received packet has wrong page counter value.";
-        transmitStatement(WARNING);
+        if (nak_received) {
+            msg << "Response packet is \"NAK\" (15h). Device cannot fullfill request.";
+            transmitStatement(WARNING);
+        }
+
+        else {
+            msg << "Device does not respond.";
+            transmitStatement(ERROR);
+        }
 
         return false;
 
@@ -495,9 +728,9 @@ bool Dgps::getDgpsData() {
 
     else {
 
-        // hereby called functions analyze the received packet in-depth, structure it, extract and finnaly serve GPS data;
+        // hereby called functions analyze the position record in-depth, structure it, extract and finnaly serve GPS data;
         // if everything works fine, GPS data is getting stored in Dgps::GpsData gps_data;
-        if (!analyzeData(debugged_buffer, bytes_received_debugged)) {
+        if (!extractGpsData(cache.front())) {
 
             msg << "Failed to gather GPS data.";
             transmitStatement(WARNING);
@@ -524,51 +757,19 @@ bool Dgps::getDgpsData() {
 /**************************************************/
 /**************************************************/
 
-bool Dgps::analyzeData(unsigned char *  buffer,         // points to received packet from serialIO (char array);
-                       int              buffer_size) {  // number of received bytes;
-
-    /**************************************************/
-    /**************************************************/
-    /**************************************************/
-
-    // --- header ---
-    temp_packet.stx         = buffer[0];
-    temp_packet.status      = buffer[1];
-    temp_packet.packet_type = buffer[2];
-    temp_packet.length      = buffer[3];
-
-    // --- data part header ---
-    temp_packet.record_type                 = buffer[4];
-    temp_packet.page_counter                = buffer[5];
-    temp_packet.reply_number                = buffer[6];
-    temp_packet.record_interpretation_flags = buffer[7];
-
-    // --- data part ---
-
-    temp_packet.data_bytes.resize(temp_packet.length);
-
-    for (int i = 0; i < (temp_packet.length - 4); i++)
-        temp_packet.data_bytes[i] = buffer[8 + i];
-
-    // --- tail ---
-    temp_packet.checksum    = buffer[temp_packet.length + 4]       ;
-    temp_packet.etx         = buffer[temp_packet.length + 4 + 1]   ;
+bool Dgps::extractGpsData(const RawRecord & position_record) {
 
     /**************************************************/
     /**************************************************/
     /**************************************************/
 
-    // verify checksum;
-    unsigned char checksum = 0x00;
-            
-    // calculate checksum over data bytes;
-    for (int i = 1; i < temp_packet.length+4; i++)
-        checksum += buffer[i];
+    // the fields are decoded straight from the record data (see RecordDecoder.h);
+    size_t record_size              = position_record.data.size();
+    const unsigned char * record    = record_size > 0 ? &position_record.data[0] : NULL;
 
-    // check for checksum mismatch;
-    if (checksum != temp_packet.checksum) {
+    if (record_size < PositionRecord::size) {
 
-        msg << "Checksum mismatch. "<<(int)checksum<<" != "<<(int)temp_packet.checksum;
+        msg << "Position record too short. " << record_size << " < " << PositionRecord::size;
         transmitStatement(WARNING);
 
         return false;
@@ -579,70 +780,21 @@ bool Dgps::analyzeData(unsigned char *  buffer,         // points to received pa
     /**************************************************/
     /**************************************************/
 
-    else {
-
-        return extractGpsData();
-
-    }
-
-    /**************************************************/
-    /**************************************************/
-    /**************************************************/
-
-}
-
-/**************************************************/
-/**************************************************/
-/**************************************************/
-
-bool Dgps::extractGpsData() {
-
-    /**************************************************/
-    /**************************************************/
-    /**************************************************/
-
     // get all fields of type DOUBLE (8 bytes);
 
-    unsigned char latitude_bytes            [8];
-    unsigned char longitude_bytes           [8];
-    unsigned char altitude_bytes            [8];
-    unsigned char clock_offset_bytes        [8];
-    unsigned char frequency_offset_bytes    [8];
-    unsigned char pdop_bytes                [8];
-    unsigned char latitude_rate_bytes       [8];
-    unsigned char longitude_rate_bytes      [8];
-    unsigned char altitude_rate_bytes       [8];
-
-    for (int i = 0; i < 8; i++) {
-
-        latitude_bytes          [i] = temp_packet.data_bytes[i + 0];
-        longitude_bytes         [i] = temp_packet.data_bytes[i + 8];
-        altitude_bytes          [i] = temp_packet.data_bytes[i + 16];
-        clock_offset_bytes      [i] = temp_packet.data_bytes[i + 24];
-        frequency_offset_bytes  [i] = temp_packet.data_bytes[i + 32];
-        pdop_bytes              [i] = temp_packet.data_bytes[i + 40];
-        latitude_rate_bytes     [i] = temp_packet.data_bytes[i + 48];
-        longitude_rate_bytes    [i] = temp_packet.data_bytes[i + 56];
-        altitude_rate_bytes     [i] = temp_packet.data_bytes[i + 64];
-
-    }
-
     // helper variable; used to find the meaning of semi-circles in this case...
     // (it's just 0-180 normalized to 0.0-1.0)
     double semi_circle_factor = 180.0;
 
-    // getDOUBLE includes inverting of bit order;
-    // neccessary because of motorola format;
-    // see Trimbel BD982 GNSS Receiver Manual, p. 66ff;
-    gps_data.latitude_value     = getDOUBLE(latitude_bytes) * semi_circle_factor;
-    gps_data.longitude_value    = getDOUBLE(longitude_bytes) * semi_circle_factor;
-    gps_data.altitude_value     = getDOUBLE(altitude_bytes);
-    gps_data.clock_offset       = getDOUBLE(clock_offset_bytes);
-    gps_data.frequency_offset   = getDOUBLE(frequency_offset_bytes);
-    gps_data.pdop               = getDOUBLE(pdop_bytes);
-    gps_data.latitude_rate      = getDOUBLE(latitude_rate_bytes);
-    gps_data.longitude_rate     = getDOUBLE(longitude_rate_bytes);
-    gps_data.altitude_rate      = getDOUBLE(altitude_rate_bytes);
+    gps_data.latitude_value     = RecordDecoder::get<PositionRecord::Latitude>          (record) * semi_circle_factor;
+    gps_data.longitude_value    = RecordDecoder::get<PositionRecord::Longitude>         (record) * semi_circle_factor;
+    gps_data.altitude_value     = RecordDecoder::get<PositionRecord::Altitude>          (record);
+    gps_data.clock_offset       = RecordDecoder::get<PositionRecord::ClockOffset>       (record);
+    gps_data.frequency_offset   = RecordDecoder::get<PositionRecord::FrequencyOffset>   (record);
+    gps_data.pdop               = RecordDecoder::get<PositionRecord::Pdop>              (record);
+    gps_data.latitude_rate      = RecordDecoder::get<PositionRecord::LatitudeRate>      (record);
+    gps_data.longitude_rate     = RecordDecoder::get<PositionRecord::LongitudeRate>     (record);
+    gps_data.altitude_rate      = RecordDecoder::get<PositionRecord::AltitudeRate>      (record);
 
     /**************************************************/
     /**************************************************/
@@ -650,16 +802,7 @@ bool Dgps::extractGpsData() {
 
     // get all fields of type LONG (4 bytes)
 
-    unsigned char gps_msec_of_week_bytes[4];
-
-    for (int i = 0; i < 4; i++) {
-
-        gps_msec_of_week_bytes[i]   = temp_packet.data_bytes[i + 72];
-
-    }
-
-    // getLONG includes inverting of bit order
-    gps_data.gps_msec_of_week = getLONG(gps_msec_of_week_bytes);
+    gps_data.gps_msec_of_week   = RecordDecoder::get<PositionRecord::GpsMsecOfWeek>     (record);
 
     /**************************************************/
     /**************************************************/
@@ -667,18 +810,29 @@ bool Dgps::extractGpsData() {
 
     // get all fields of type CHAR (1 byte)
 
-    gps_data.position_flags = getCHAR(temp_packet.data_bytes[76]);
-    gps_data.number_of_SVs  = getCHAR(temp_packet.data_bytes[77]);
+    gps_data.position_flags     = RecordDecoder::get<PositionRecord::PositionFlags>     (record);
+    int number_of_SVs           = RecordDecoder::get<PositionRecord::NumberOfSVs>       (record);
+
+    if (record_size < PositionRecord::size + number_of_SVs * PositionRecord::sv_size) {
+
+        msg << "Position record too short for " << number_of_SVs << " satellites.";
+        transmitStatement(WARNING);
+
+        return false;
+
+    }
+
+    gps_data.number_of_SVs      = (char) number_of_SVs;
 
-    // first getting rid of old values
+    // first getting rid of old values (keeps the capacity of the vectors)
     gps_data.channel_numbers.clear();
     gps_data.prn.clear();
 
     // gathering new values according to number of satellites
-    for (int i = 0; i < gps_data.number_of_SVs; i++) {
+    for (int i = 0; i < number_of_SVs; i++) {
 
-        gps_data.channel_numbers.push_back  (getCHAR(temp_packet.data_bytes[78 + i*2]));
-        gps_data.prn.push_back              (getCHAR(temp_packet.data_bytes[79 + i*2]));
+        gps_data.channel_numbers.push_back  (RecordDecoder::get<PositionRecord::ChannelNumber>(record, PositionRecord::sv_size, i));
+        gps_data.prn.push_back              (RecordDecoder::get<PositionRecord::Prn>          (record, PositionRecord::sv_size, i));
 
     }
 
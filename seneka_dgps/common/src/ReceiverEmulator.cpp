@@ -0,0 +1,691 @@
+/*!
+*****************************************************************
+* ReceiverEmulator.cpp
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_dgps
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description: The seneka_dgps package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* It implements a GNU/Linux driver for the Trimble BD982 GNSS Receiver Module as well as a ROS publisher node "DGPS", which acts as a wrapper for the driver.
+* The ROS node "DGPS" publishes GPS data gathered by the DGPS device driver.
+* This package might work with other hardware and can be used for other purposes, however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#include <seneka_dgps/ReceiverEmulator.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+// number of records whose send time is kept;
+#define SEND_TIMES ( 1024 )
+
+// start of the trajectory and its velocity;
+#define START_LATITUDE  ( 48.7433 )     // [] = deg
+#define START_LONGITUDE ( 9.0978 )      // [] = deg
+#define START_ALTITUDE  ( 450.0 )       // [] = m
+#define VELOCITY_NORTH  ( 1.0 )         // [] = m/s
+#define VELOCITY_EAST   ( 0.5 )         // [] = m/s
+#define VELOCITY_UP     ( 0.0 )         // [] = m/s
+
+#define EARTH_RADIUS    ( 6378137.0 )   // [] = m; WGS84 semi-major axis
+
+// difference between GPS time and UTC in s, valid since 01/2017;
+#define LEAP_SECONDS    ( 18 )
+
+#define MSEC_OF_WEEK    ( 604800000L )
+
+/*********************************************************************/
+/*************** ReceiverEmulator class implementation ***************/
+/*********************************************************************/
+
+ReceiverEmulator::ReceiverEmulator(const Config & config) : config(config) {
+
+    master              = -1;
+    slave               = -1;
+    running             = false;
+    statistics          = Statistics();
+    last_msec_of_week   = -1;
+    packet_size         = 0;
+    reply_number        = 0;
+    seed                = 1;
+
+}
+
+ReceiverEmulator::~ReceiverEmulator() {
+
+    close();
+
+}
+
+/**************************************************/
+/**************************************************/
+/**************************************************/
+
+bool ReceiverEmulator::open(const std::string & link) {
+
+    close();
+
+    char name[256];
+
+    if (openpty(&master, &slave, name, NULL, NULL) != 0)
+        return false;
+
+    // the slave stays open, otherwise reading the master fails while no client has opened the port;
+    struct termios attributes;
+    tcgetattr(slave, &attributes);
+    cfmakeraw(&attributes);
+    tcsetattr(slave, TCSANOW, &attributes);
+
+    // a reply which does not fit into the buffer of a port which is not read is dropped instead of blocking;
+    fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+
+    device_name = name;
+
+    if (!link.empty()) {
+
+        unlink(link.c_str());
+
+        if (symlink(name, link.c_str()) != 0) {
+            close();
+            return false;
+        }
+
+        link_name = link;
+
+    }
+
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        running             = true;
+        statistics          = Statistics();
+        start_time          = boost::get_system_time();
+        outage_end          = boost::system_time();
+        send_times.clear();
+    }
+
+    packet_size = 0;
+    thread      = boost::thread(boost::bind(&ReceiverEmulator::run, this));
+
+    return true;
+
+}
+
+void ReceiverEmulator::close() {
+
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        running = false;
+    }
+
+    if (thread.joinable())
+        thread.join();
+
+    if (!link_name.empty()) {
+        unlink(link_name.c_str());
+        link_name.clear();
+    }
+
+    if (slave >= 0)
+        ::close(slave);
+
+    if (master >= 0)
+        ::close(master);
+
+    slave   = -1;
+    master  = -1;
+
+    device_name.clear();
+
+}
+
+/**************************************************/
+/**************************************************/
+/**************************************************/
+
+void ReceiverEmulator::setConfig(const Config & config) {
+
+    boost::mutex::scoped_lock lock(mutex);
+    this->config = config;
+
+}
+
+ReceiverEmulator::Config ReceiverEmulator::getConfig() {
+
+    boost::mutex::scoped_lock lock(mutex);
+    return config;
+
+}
+
+void ReceiverEmulator::interrupt(int duration) {
+
+    boost::mutex::scoped_lock lock(mutex);
+    outage_end = boost::get_system_time() + boost::posix_time::milliseconds(duration);
+
+}
+
+ReceiverEmulator::Statistics ReceiverEmulator::getStatistics() {
+
+    boost::mutex::scoped_lock lock(mutex);
+    return statistics;
+
+}
+
+bool ReceiverEmulator::sendTime(long gps_msec_of_week, boost::system_time & time) {
+
+    boost::system_time epoch_time;
+
+    return sendTime(gps_msec_of_week, epoch_time, time);
+
+}
+
+bool ReceiverEmulator::sendTime(long gps_msec_of_week, boost::system_time & epoch_time, boost::system_time & time) {
+
+    boost::mutex::scoped_lock lock(mutex);
+
+    for (std::deque<SentRecord>::reverse_iterator it = send_times.rbegin(); it != send_times.rend(); it++) {
+
+        if (it->msec_of_week == gps_msec_of_week) {
+            epoch_time  = it->epoch_time;
+            time        = it->send_time;
+            return true;
+        }
+
+    }
+
+    return false;
+
+}
+
+bool ReceiverEmulator::outage() {
+
+    boost::mutex::scoped_lock lock(mutex);
+    return !outage_end.is_not_a_date_time() && boost::get_system_time() < outage_end;
+
+}
+
+/**************************************************/
+/**************************************************/
+/**************************************************/
+
+void ReceiverEmulator::run() {
+
+    unsigned char buffer[256];
+    boost::system_time next_epoch = boost::get_system_time();
+
+    while (true) {
+
+        double stream_rate;
+
+        {
+            boost::mutex::scoped_lock lock(mutex);
+
+            if (!running)
+                return;
+
+            stream_rate = config.stream_rate;
+        }
+
+        // waits for requests until the next streamed epoch, at most 10 ms to notice close();
+        int timeout = 10;
+        boost::system_time now = boost::get_system_time();
+
+        if (stream_rate > 0.0)
+            timeout = std::max(0, std::min(timeout, (int) (next_epoch - now).total_milliseconds()));
+
+        struct pollfd descriptor;
+        descriptor.fd       = master;
+        descriptor.events   = POLLIN;
+
+        if (poll(&descriptor, 1, timeout) > 0 && (descriptor.revents & POLLIN)) {
+
+            ssize_t size = read(master, buffer, sizeof(buffer));
+
+            for (ssize_t i = 0; i < size; i++)
+                receive(buffer[i]);
+
+        }
+
+        if (stream_rate <= 0.0)
+            continue;
+
+        now = boost::get_system_time();
+
+        if (now < next_epoch)
+            continue;
+
+        // epochs which could not be sent in time are skipped;
+        boost::posix_time::time_duration period = boost::posix_time::microseconds((long) (1e6 / stream_rate));
+
+        next_epoch += period;
+        if (next_epoch < now)
+            next_epoch = now + period;
+
+        if (outage()) {
+            boost::mutex::scoped_lock lock(mutex);
+            statistics.drops++;
+        }
+
+        else {
+            sendRecord(false);
+        }
+
+    }
+
+}
+
+/**************************************************/
+/**************************************************/
+/**************************************************/
+
+// a request packet: stx (02h), status, packet type, length, <length> data bytes, checksum, etx (03h);
+void ReceiverEmulator::receive(unsigned char byte) {
+
+    if (packet_size == 0) {
+
+        // "ENQ" (05h) outside of packets is answered with "ACK" (06h);
+        if (byte == 0x05) {
+
+            {
+                boost::mutex::scoped_lock lock(mutex);
+                statistics.enquiries++;
+            }
+
+            if (!outage()) {
+                unsigned char ack = 0x06;
+                write(&ack, 1, 0);
+            }
+
+        }
+
+        // other bytes outside of packets are ignored;
+        else if (byte == 0x02) {
+
+            packet[packet_size++] = byte;
+
+        }
+
+        return;
+
+    }
+
+    packet[packet_size++] = byte;
+
+    if (packet_size >= 4 && packet_size == 4 + (size_t) packet[3] + 2) {
+
+        handleRequest();
+        packet_size = 0;
+
+    }
+
+}
+
+void ReceiverEmulator::handleRequest() {
+
+    unsigned char checksum = 0;
+
+    for (size_t i = 1; i < packet_size - 2; i++)
+        checksum += packet[i];
+
+    // "GETRAW" (56h) with a raw data type up to 0Fh;
+    bool valid = packet[packet_size - 1] == 0x03 && packet[packet_size - 2] == checksum
+              && packet[2] == 0x56 && packet[3] >= 1 && packet[4] <= 0x0f;
+
+    Config current = getConfig();
+
+    if (!valid) {
+
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            statistics.invalid_requests++;
+        }
+
+        unsigned char nak = 0x15;
+        write(&nak, 1, 0);
+
+        return;
+
+    }
+
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        statistics.requests++;
+    }
+
+    if (outage() || uniform() < current.drop_probability) {
+
+        boost::mutex::scoped_lock lock(mutex);
+        statistics.drops++;
+
+        return;
+
+    }
+
+    int delay = current.reply_delay + (int) (uniform() * (current.reply_jitter + 1));
+
+    if (delay > 0)
+        boost::this_thread::sleep(boost::posix_time::milliseconds(delay));
+
+    if (packet[4] == 0x01)
+        sendRecord(true);
+    else
+        sendPages(packet[4]);
+
+}
+
+/**************************************************/
+/**************************************************/
+/**************************************************/
+
+// writes value in motorola format (big-endian);
+static void encode(std::vector<unsigned char> & bytes, unsigned long long value, int size) {
+
+    for (int i = 0; i < size; i++)
+        bytes.push_back((unsigned char) (value >> (8 * (size - 1 - i))));
+
+}
+
+static void encodeDouble(std::vector<unsigned char> & bytes, double value) {
+
+    unsigned long long bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    encode(bytes, bits, 8);
+
+}
+
+// concise position record, see Trimble BD982 GNSS Receiver Manual, p. 139f;
+void ReceiverEmulator::sendRecord(bool requested) {
+
+    Config current = getConfig();
+
+    double fault = uniform();
+
+    // "NAK" (15h) is only a reply to a request;
+    if (requested && fault < current.nak_probability) {
+
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            statistics.naks++;
+        }
+
+        unsigned char nak = 0x15;
+        write(&nak, 1, current.baud_rate);
+
+        return;
+
+    }
+
+    bool bad_checksum   = fault >= current.nak_probability && fault < current.nak_probability + current.checksum_probability;
+    bool split          = uniform() < current.split_probability;
+
+    /**************************************************/
+    /**************************************************/
+    /**************************************************/
+
+    boost::posix_time::ptime utc = boost::posix_time::microsec_clock::universal_time();
+    boost::posix_time::ptime gps_epoch(boost::gregorian::date(1980, 1, 6));
+
+    long long gps_msec = (utc - gps_epoch).total_milliseconds() + LEAP_SECONDS * 1000LL;
+
+    // every record gets its own GPS time;
+    if (gps_msec % MSEC_OF_WEEK == last_msec_of_week)
+        gps_msec++;
+
+    long msec_of_week = (long) (gps_msec % MSEC_OF_WEEK);
+
+    last_msec_of_week = msec_of_week;
+
+    SentRecord sent;
+    sent.msec_of_week   = msec_of_week;
+    sent.epoch_time     = gps_epoch + boost::posix_time::milliseconds(gps_msec - LEAP_SECONDS * 1000LL);
+
+    // position on the trajectory plus noise;
+    double time         = (boost::get_system_time() - start_time).total_microseconds() / 1e6;
+    double north        = VELOCITY_NORTH * time + gaussian() * current.position_noise;
+    double east         = VELOCITY_EAST  * time + gaussian() * current.position_noise;
+    double up           = VELOCITY_UP    * time + gaussian() * current.position_noise;
+
+    double latitude     = START_LATITUDE * M_PI / 180.0 + north / EARTH_RADIUS;                                   // [] = rad
+    double longitude    = START_LONGITUDE * M_PI / 180.0 + east / (EARTH_RADIUS * cos(START_LATITUDE * M_PI / 180.0));
+
+    int satellites      = std::max(0, std::min(12, current.satellites));
+
+    std::vector<unsigned char> reply;
+    reply.reserve(4 + 4 + 78 + 2 * 12 + 2);
+
+    reply.push_back(0x02);                                  // stx
+    reply.push_back(0x00);                                  // status
+    reply.push_back(0x57);                                  // packet type "RAWDATA" (57h)
+    reply.push_back((unsigned char) (4 + 78 + 2 * satellites));
+
+    reply.push_back(0x01);                                  // record type: position record
+    reply.push_back(0x11);                                  // page 1 of 1
+    reply.push_back(0x00);                                  // reply number
+    reply.push_back(0x01);                                  // record interpretation flags: concise
+
+    encodeDouble(reply, latitude / M_PI);                   // [] = semi-circles
+    encodeDouble(reply, longitude / M_PI);                  // [] = semi-circles
+    encodeDouble(reply, START_ALTITUDE + up);               // [] = m
+    encodeDouble(reply, 0.0);                               // clock offset
+    encodeDouble(reply, 0.0);                               // frequency offset
+    encodeDouble(reply, 1.5);                               // pdop
+    encodeDouble(reply, VELOCITY_NORTH / EARTH_RADIUS);     // latitude rate [] = rad/s
+    encodeDouble(reply, VELOCITY_EAST / (EARTH_RADIUS * cos(latitude)));
+    encodeDouble(reply, VELOCITY_UP);                       // altitude rate [] = m/s
+    encode(reply, msec_of_week, 4);
+    reply.push_back(0x01);                                  // position flags: new position
+    reply.push_back((unsigned char) satellites);
+
+    for (int i = 0; i < satellites; i++) {
+        reply.push_back((unsigned char) i);                 // channel number
+        reply.push_back((unsigned char) (i * 3 + 2));       // prn
+    }
+
+    unsigned char checksum = 0;
+
+    for (size_t i = 1; i < reply.size(); i++)
+        checksum += reply[i];
+
+    if (bad_checksum)
+        checksum++;
+
+    reply.push_back(checksum);
+    reply.push_back(0x03);                                  // etx
+
+    /**************************************************/
+    /**************************************************/
+    /**************************************************/
+
+    bool written;
+
+    if (split) {
+
+        size_t first = reply.size() / 2;
+
+        written = write(&reply[0], first, current.baud_rate);
+
+        boost::this_thread::sleep(boost::posix_time::milliseconds(current.split_delay));
+
+        written = write(&reply[first], reply.size() - first, current.baud_rate) && written;
+
+    }
+
+    else {
+
+        written = write(&reply[0], reply.size(), current.baud_rate);
+
+    }
+
+    boost::mutex::scoped_lock lock(mutex);
+
+    if (split)
+        statistics.splits++;
+
+    if (bad_checksum) {
+        statistics.bad_checksums++;
+        return;
+    }
+
+    if (!written)
+        return;
+
+    statistics.records++;
+
+    sent.send_time = boost::get_system_time();
+    send_times.push_back(sent);
+
+    if (send_times.size() > SEND_TIMES)
+        send_times.pop_front();
+
+}
+
+// other record types are not interpreted, their data is a counter;
+// see Trimble BD982 GNSS Receiver Manual, p. 132;
+void ReceiverEmulator::sendPages(unsigned char record_type) {
+
+    Config current = getConfig();
+
+    // 240 data bytes per page;
+    const int page_size = 240;
+    int pages           = std::max(1, std::min(15, current.record_pages));
+
+    reply_number++;
+
+    bool written = true;
+
+    for (int page = 1; page <= pages; page++) {
+
+        std::vector<unsigned char> reply;
+        reply.reserve(4 + 4 + page_size + 2);
+
+        reply.push_back(0x02);                                          // stx
+        reply.push_back(0x00);                                          // status
+        reply.push_back(0x57);                                          // packet type "RAWDATA" (57h)
+        reply.push_back((unsigned char) (4 + page_size));
+
+        reply.push_back(record_type);
+        reply.push_back((unsigned char) ((page << 4) | pages));         // page counter
+        reply.push_back(reply_number);
+        reply.push_back(0x00);                                          // record interpretation flags
+
+        for (int i = 0; i < page_size; i++)
+            reply.push_back((unsigned char) ((page - 1) * page_size + i));
+
+        unsigned char checksum = 0;
+
+        for (size_t i = 1; i < reply.size(); i++)
+            checksum += reply[i];
+
+        reply.push_back(checksum);
+        reply.push_back(0x03);                                          // etx
+
+        written = write(&reply[0], reply.size(), current.baud_rate) && written;
+
+    }
+
+    boost::mutex::scoped_lock lock(mutex);
+
+    if (written)
+        statistics.records++;
+
+}
+
+/**************************************************/
+/**************************************************/
+/**************************************************/
+
+// the bytes of a chunk are written after their transmission time, so that they arrive like on a serial line;
+bool ReceiverEmulator::write(const unsigned char * data, size_t size, int baud_rate) {
+
+    const size_t chunk = 8;
+
+    while (size > 0) {
+
+        size_t part = std::min(size, baud_rate > 0 ? chunk : size);
+
+        // 10 bits per byte (start bit, 8 data bits, stop bit);
+        if (baud_rate > 0)
+            boost::this_thread::sleep(boost::posix_time::microseconds((long) (part * 10e6 / baud_rate)));
+
+        ssize_t written = ::write(master, data, part);
+
+        if (written <= 0)
+            return false;
+
+        data += written;
+        size -= written;
+
+    }
+
+    return true;
+
+}
+
+double ReceiverEmulator::uniform() {
+
+    return rand_r(&seed) / (RAND_MAX + 1.0);
+
+}
+
+// Box-Muller transform;
+double ReceiverEmulator::gaussian() {
+
+    double u = 1.0 - uniform();
+    double v = uniform();
+
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+
+}
@@ -0,0 +1,230 @@
+/*!
+*****************************************************************
+* recordDecoderBenchmark.cpp
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_dgps
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description: The seneka_dgps package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* It implements a GNU/Linux driver for the Trimble BD982 GNSS Receiver Module as well as a ROS publisher node "DGPS", which acts as a wrapper for the driver.
+* The ROS node "DGPS" publishes GPS data gathered by the DGPS device driver.
+* This package might work with other hardware and can be used for other purposes, however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+// Micro-benchmark and equivalence check of the position record decoding:
+// compares the bit-wise functions of Dgps (getDOUBLE, getLONG, getCHAR) with
+// RecordDecoder on random position records.
+//
+// usage: record_decoder_benchmark [records iterations]
+
+#include <seneka_dgps/Dgps.h>
+#include <seneka_dgps/RecordDecoder.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+// writes value in motorola format (big-endian)
+static void encode(unsigned char * bytes, uint64_t value, int size) {
+
+    for (int i = 0; i < size; i++)
+        bytes[i] = (unsigned char) (value >> (8 * (size - 1 - i)));
+
+}
+
+static void encodeDouble(unsigned char * bytes, double value) {
+
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    encode(bytes, bits, 8);
+
+}
+
+static double randomDouble(double range) {
+
+    return (2.0 * rand() / RAND_MAX - 1.0) * range;
+
+}
+
+// random position record including its satellite blocks
+static void randomRecord(unsigned char * record) {
+
+    encodeDouble(record +  0, randomDouble(0.5));
+    encodeDouble(record +  8, randomDouble(1.0));
+    encodeDouble(record + 16, randomDouble(1000.0));
+    encodeDouble(record + 24, randomDouble(1e5));
+    encodeDouble(record + 32, randomDouble(1e3));
+    encodeDouble(record + 40, fabs(randomDouble(10.0)));
+    encodeDouble(record + 48, randomDouble(1e-6));
+    encodeDouble(record + 56, randomDouble(1e-6));
+    encodeDouble(record + 64, randomDouble(1.0));
+    encode(record + 72, rand() % 604800000, 4);
+    record[76] = (unsigned char) rand();
+    record[77] = 12;
+
+    for (int i = 0; i < 12 * 2; i++)
+        record[78 + i] = (unsigned char) rand();
+
+}
+
+// microseconds per record since start
+static double elapsed(const boost::posix_time::ptime & start, int records) {
+
+    return (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / (double) records;
+
+}
+
+int main(int argc, char** argv) {
+
+    int records = 1000, iterations = 100;
+
+    if (argc == 3) {
+        records     = atoi(argv[1]);
+        iterations  = atoi(argv[2]);
+    }
+
+    if (records <= 0 || iterations <= 0) {
+        printf("usage: %s [records iterations]\n", argv[0]);
+        return 1;
+    }
+
+    const int record_size = PositionRecord::size + 12 * PositionRecord::sv_size;
+    std::vector<unsigned char> data(records * record_size);
+
+    srand(1);
+    for (int r = 0; r < records; r++)
+        randomRecord(&data[r * record_size]);
+
+    Dgps dgps;
+
+    /**************************************************/
+    /*************** equivalence check ***************/
+    /**************************************************/
+
+    int double_mismatches = 0, long_mismatches = 0, char_mismatches = 0;
+
+    for (int r = 0; r < records; r++) {
+
+        unsigned char * record = &data[r * record_size];
+
+        for (int f = 0; f < 9; f++) {
+            double value;
+            RecordDecoder::decode(record + 8 * f, value);
+            if (dgps.getDOUBLE(record + 8 * f) != value)
+                double_mismatches++;
+        }
+
+        if (dgps.getLONG(record + 72) != (long) RecordDecoder::get<PositionRecord::GpsMsecOfWeek>(record))
+            long_mismatches++;
+
+    }
+
+    for (int c = 0; c < 256; c++) {
+        unsigned char byte = (unsigned char) c;
+        if (dgps.getCHAR(byte) != RecordDecoder::get<RecordDecoder::Field<char, 0> >(&byte))
+            char_mismatches++;
+    }
+
+    // values which the bit-wise decoding does not handle
+    unsigned char zero[8] = {0};
+    double zero_value;
+    RecordDecoder::decode(zero, zero_value);
+
+    printf("%d records, %d iterations\n", records, iterations);
+    printf("DOUBLE: %d of %d values differ\n", double_mismatches, records * 9);
+    printf("CHAR:   %d of 256 values differ\n", char_mismatches);
+    printf("LONG:   %d of %d values differ (getLONG overlaps the bits of its bytes)\n", long_mismatches, records);
+    printf("0.0:    getDOUBLE %g, RecordDecoder %g (getDOUBLE has no special case for zero)\n", dgps.getDOUBLE(zero), zero_value);
+
+    /**************************************************/
+    /*************** benchmark ************************/
+    /**************************************************/
+
+    volatile double sink = 0;
+
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    for (int i = 0; i < iterations; i++) {
+        for (int r = 0; r < records; r++) {
+            unsigned char * record = &data[r * record_size];
+            double sum = 0;
+            for (int f = 0; f < 9; f++)
+                sum += dgps.getDOUBLE(record + 8 * f);
+            sum += dgps.getLONG(record + 72) + dgps.getCHAR(record[76]) + dgps.getCHAR(record[77]);
+            sink = sink + sum;
+        }
+    }
+    double bitwise_us = elapsed(start, records * iterations);
+
+    start = boost::posix_time::microsec_clock::universal_time();
+    for (int i = 0; i < iterations; i++) {
+        for (int r = 0; r < records; r++) {
+            const unsigned char * record = &data[r * record_size];
+            double sum = RecordDecoder::get<PositionRecord::Latitude>(record)
+                       + RecordDecoder::get<PositionRecord::Longitude>(record)
+                       + RecordDecoder::get<PositionRecord::Altitude>(record)
+                       + RecordDecoder::get<PositionRecord::ClockOffset>(record)
+                       + RecordDecoder::get<PositionRecord::FrequencyOffset>(record)
+                       + RecordDecoder::get<PositionRecord::Pdop>(record)
+                       + RecordDecoder::get<PositionRecord::LatitudeRate>(record)
+                       + RecordDecoder::get<PositionRecord::LongitudeRate>(record)
+                       + RecordDecoder::get<PositionRecord::AltitudeRate>(record);
+            sum += RecordDecoder::get<PositionRecord::GpsMsecOfWeek>(record)
+                 + RecordDecoder::get<PositionRecord::PositionFlags>(record)
+                 + RecordDecoder::get<PositionRecord::NumberOfSVs>(record);
+            sink = sink + sum;
+        }
+    }
+    double decoder_us = elapsed(start, records * iterations);
+
+    printf("bit-wise:      %10.4f us/record\n", bitwise_us);
+    printf("RecordDecoder: %10.4f us/record (x%.0f)\n", decoder_us, decoder_us > 0 ? bitwise_us / decoder_us : 0.0);
+
+    // the bit-wise LONG decoding is known to be wrong
+    return (double_mismatches == 0 && char_mismatches == 0) ? 0 : 1;
+
+}
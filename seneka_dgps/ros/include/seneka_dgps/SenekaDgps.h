@@ -65,9 +65,13 @@
 
 #include <ros/ros.h>
 #include <seneka_msg/dgpsPosition.h>
-#include <diagnostic_msgs/DiagnosticArray.h>
+#include <seneka_diagnostics/DiagnosticsAggregator.h>
 
 #include <seneka_dgps/Dgps.h>
+#include <seneka_dgps/PositionEstimator.h>
+#include <seneka_dgps/GpsTime.h>
+
+#include <boost/thread.hpp>
 
 #include <sstream>
 
@@ -82,25 +86,65 @@ class SenekaDgps {
         // default parameters; initialization in constructor;
         std::string position_topic;     // topic for publishing dgps data;
         std::string diagnostics_topic;  // topic for publishing diagnostic statements;
+        std::string estimate_topic;     // topic for publishing predicted positions;
         std::string serial_port;        // serial port identifier
         int         serial_baudrate;    // [] = Bd; baud rate of serial connection;
         int         publishrate;        // [] = Hz; ROS publish rate;
+        std::string request_mode;       // "polling" or "streaming";
+        double      statisticsperiod;   // [] = s; period of the position statistics;
+        double      estimatorrate;      // [] = Hz; rate of the predicted positions, 0 disables the estimator;
+        double      estimatormaxage;    // [] = s; maximum extrapolation time;
+        int         leapseconds;        // [] = s; GPS time minus UTC, negative values use the leap second table;
+        double      maxclockoffset;     // [] = s; largest offset of a host clock which is considered synchronized;
 
         // parameters from parameter server; initialization in constructor;
         std::string port;               // serial port identifier
         int         baud;               // [] = Bd; baud rate of serial connection;
         int         rate;               // [] = Hz; ROS publish rate;
+        std::string mode;               // "polling": request every position record, "streaming": receiver sends them periodically;
+        double      statistics_period;  // [] = s; period of the position statistics;
+        double      estimator_rate;     // [] = Hz; rate of the predicted positions, 0 disables the estimator;
+        double      estimator_max_age;  // [] = s; maximum extrapolation time;
+        int         leap_seconds;       // [] = s; GPS time minus UTC, negative values use the leap second table;
+        double      max_clock_offset;   // [] = s; largest offset of a host clock which is considered synchronized;
+        std::vector<int> record_types;  // raw data types requested in polling mode, e.g. [1] for the position record only;
+
+        // position statistics since statistics_start;
+        ros::Time       statistics_start;
+        unsigned long   epochs;
+        double          latency_sum;
+        double          latency_max;
+        unsigned long   missed_epochs;
+        long            last_msec_of_week;
+        long            epoch_interval;     // [] = ms; smallest interval between two epochs seen so far;
+
+        // converts the GPS time of the position records to time stamps (see seneka_dgps/GpsTime.h);
+        GpsTime         gps_time;
+        bool            clock_synchronized; // state of the last report about the host clock;
 
         // ROS messages
-        diagnostic_msgs::DiagnosticArray    diagnostics;
         seneka_msg::dgpsPosition            position;
 
+        // status of the node, published once per second (see seneka_diagnostics/DiagnosticsAggregator.h);
+        DiagnosticsAggregator               diagnostics;
+
+        // position estimator; predicts positions between the epochs from the latest fix and its rates;
+        // runs in its own thread, so that the prediction rate does not depend on the serial round trip;
+        PositionEstimator                   estimator;
+        seneka_msg::dgpsPosition            estimate;           // fields of the latest fix, guarded by estimator_mutex;
+        boost::mutex                        estimator_mutex;
+        boost::thread                       estimator_thread;
+        bool                                estimator_running;
+
+        // publishes a predicted position at estimator_rate until the node shuts down;
+        void runEstimator();
+
     public:
 
         // ROS instances (need to be public);
         ros::NodeHandle     nh;
         ros::Publisher      position_publisher;
-        ros::Publisher      diagnostics_publisher;
+        ros::Publisher      estimate_publisher;
 
         // helper variable which stores diagnostic messages temporarily;
         std::stringstream   message;
@@ -131,12 +175,21 @@ class SenekaDgps {
         std::string getSerialPort       (void)  {return serial_port;}
         int         getSerialBaudRate   (void)  {return serial_baudrate;}
         int         getPublishRate      (void)  {return publishrate;}
+        std::string getRequestMode      (void)  {return request_mode;}
+        double      getStatisticsPeriod (void)  {return statisticsperiod;}
+        double      getEstimatorRate    (void)  {return estimatorrate;}
+        double      getEstimatorMaxAge  (void)  {return estimatormaxage;}
+        int         getLeapSeconds      (void)  {return leapseconds;}
+        double      getMaxClockOffset   (void)  {return maxclockoffset;}
 
         std::string getPort             (void)  {return port;};
         int         getBaud             (void)  {return baud;};
         int         getRate             (void)  {return rate;};
+        std::string getMode             (void)  {return mode;};
+        bool        isStreaming         (void)  {return mode == "streaming";};
+
+        std::vector<unsigned char> getRecordTypes(void) {return std::vector<unsigned char>(record_types.begin(), record_types.end());}
 
-        diagnostic_msgs::DiagnosticArray    getDiagnostics  (void) {return diagnostics;}
         seneka_msg::dgpsPosition            getPosition     (void) {return position;}
 
         // setters;
@@ -147,11 +200,22 @@ class SenekaDgps {
         // ROS publishers
 
         // takes position data from DGPS device and publishes it to given ROS topic;
-        void publishPosition(Dgps::GpsData gps);
+        // the messages are stamped with the epoch of the position (its GPS time as UTC), see GpsTime;
+        // arrival_time is the reception of the position record, it resolves the GPS week and tracks the host clock offset;
+        // corrects the position estimator with it, if the estimator is enabled;
+        void publishPosition(Dgps::GpsData gps, boost::system_time arrival_time);
 
-        // takes diagnostic statements and publishes them to given topic;
+        // takes diagnostic statements, logs them and updates the status published on the diagnostics topic;
         void publishDiagnostics(DiagnosticFlag flag);
 
+        // publishes the status at once, e.g. before the node exits;
+        void flushDiagnostics() {diagnostics.flush();}
+
+        // adds a published epoch and its latency (epoch of the position to publishing) in s;
+        // epochs which were lost or replaced by a newer one are detected by gaps of the GPS time;
+        // publishes achieved rate, latency and clock offset as diagnostic statement every statistics_period seconds;
+        void addEpoch(long gps_msec_of_week, double latency);
+
         // gathers all console output which occured due to execution of functions on Dgps instance;
         // done by extracting the diagnostic statements from Dgps::diagnostic_array;
         // publishes extracted diagnostic statements on given topic by transmitting them to publishDiagnostics()-function;
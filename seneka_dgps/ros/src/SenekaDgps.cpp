@@ -58,6 +58,11 @@
 
 #include <seneka_dgps/SenekaDgps.h>
 
+#include <algorithm>
+#include <iomanip>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
 /***************************************************************/
 /*************** SenekaDgps class implementation ***************/
 /***************************************************************/
@@ -68,9 +73,16 @@ SenekaDgps::SenekaDgps() {
     // initialize default parameters;
     position_topic      = "/position";
     diagnostics_topic   = "/diagnostics";
+    estimate_topic      = "/position_estimate";
     serial_port         = "/dev/ttyUSB0";
     serial_baudrate     = 38400;            // [] = Bd
     publishrate         = 1;                // [] = Hz; must be <= 50 Hz!
+    request_mode        = "polling";
+    statisticsperiod    = 10.0;             // [] = s
+    estimatorrate       = 0.0;              // [] = Hz; disabled
+    estimatormaxage     = 2.0;              // [] = s
+    leapseconds         = -1;               // [] = s; leap second table
+    maxclockoffset      = 1.0;              // [] = s
 
     nh = ros::NodeHandle("~");
 
@@ -151,9 +163,177 @@ SenekaDgps::SenekaDgps() {
     /**************************************************/
     /**************************************************/
 
+    // gather request mode;
+    // in streaming mode the receiver sends position records on its own and the rate parameter is not used;
+    nh.param("mode", mode, getRequestMode());
+
+    if (!nh.hasParam("mode")) {
+
+        message << "Using default parameter for mode: " << getRequestMode();
+        publishDiagnostics(WARN);
+
+    }
+
+    else if (mode != "polling" && mode != "streaming") {
+
+        message << "Unknown mode \"" << mode << "\"! Using default parameter for mode: " << getRequestMode();
+        publishDiagnostics(WARN);
+
+        mode = getRequestMode();
+
+    }
+
+    else {
+
+        message << "Mode: " << getMode();
+        publishDiagnostics(INFO);
+
+    }
+
+    /**************************************************/
+    /**************************************************/
+    /**************************************************/
+
+    // gather period of the position statistics;
+    nh.param("statistics_period", statistics_period, getStatisticsPeriod());
+
+    if (!nh.hasParam("statistics_period")) {
+
+        message << "Using default parameter for statistics period: " << getStatisticsPeriod() << " s";
+        publishDiagnostics(WARN);
+
+    }
+
+    /**************************************************/
+    /**************************************************/
+    /**************************************************/
+
+    // gather raw data types which are requested in polling mode;
+    // all of them are requested at once, the position record (1) is published;
+    nh.param("record_types", record_types, std::vector<int>(1, 1));
+
+    for (std::vector<int>::iterator it = record_types.begin(); it != record_types.end(); ) {
+
+        if (*it < 0 || *it > (int) RecordAssembler::max_record_type) {
+
+            message << "Record type " << *it << " is out of range (0 <= type <= " << RecordAssembler::max_record_type << ")! Ignoring it.";
+            publishDiagnostics(WARN);
+
+            it = record_types.erase(it);
+
+        }
+
+        else {
+
+            it++;
+
+        }
+
+    }
+
+    // the position record is published, so it is always requested;
+    if (std::find(record_types.begin(), record_types.end(), 1) == record_types.end()) {
+
+        message << "Record types do not contain the position record (1)! Requesting it as well.";
+        publishDiagnostics(WARN);
+
+        record_types.insert(record_types.begin(), 1);
+
+    }
+
+    if (record_types.size() > 1) {
+
+        message << "Requesting " << record_types.size() << " record types per cycle.";
+        publishDiagnostics(INFO);
+
+    }
+
+    /**************************************************/
+    /**************************************************/
+    /**************************************************/
+
+    // gather rate and maximum extrapolation time of the position estimator;
+    // the estimator is optional, it only runs if a rate is given;
+    nh.param("estimator_rate", estimator_rate, getEstimatorRate());
+    nh.param("estimator_max_age", estimator_max_age, getEstimatorMaxAge());
+
+    if (estimator_rate < 0.0 || estimator_rate > 1000.0) {
+
+        message << "Given estimator rate is out of range (0 Hz <= f <= 1000 Hz)! Disabling the position estimator.";
+        publishDiagnostics(WARN);
+
+        estimator_rate = 0.0;
+
+    }
+
+    else if (estimator_rate > 0.0) {
+
+        message << "Position estimator: " << estimator_rate << " Hz, maximum extrapolation " << estimator_max_age << " s";
+        publishDiagnostics(INFO);
+
+    }
+
+    estimator           = PositionEstimator(1.0, 0.1, estimator_max_age);
+    estimator_running   = false;
+
+    /**************************************************/
+    /**************************************************/
+    /**************************************************/
+
+    // gather the conversion of GPS time to time stamps;
+    // the difference of GPS time and UTC is taken from the leap second table unless it is given;
+    nh.param("leap_seconds", leap_seconds, getLeapSeconds());
+    nh.param("max_clock_offset", max_clock_offset, getMaxClockOffset());
+
+    if (leap_seconds >= 0) {
+
+        message << "Using " << leap_seconds << " s as difference of GPS time and UTC instead of the leap second table.";
+        publishDiagnostics(INFO);
+
+    }
+
+    if (max_clock_offset < 0.0) {
+
+        message << "Given maximum clock offset is negative! Using default parameter for maximum clock offset: " << getMaxClockOffset() << " s";
+        publishDiagnostics(WARN);
+
+        max_clock_offset = getMaxClockOffset();
+
+    }
+
+    gps_time            = GpsTime(leap_seconds, max_clock_offset);
+    clock_synchronized  = true;
+
+    /**************************************************/
+    /**************************************************/
+    /**************************************************/
+
+    epochs          = 0;
+    latency_sum     = 0.0;
+    latency_max     = 0.0;
+    missed_epochs   = 0;
+    last_msec_of_week   = -1;
+    epoch_interval      = 0;
+
+    /**************************************************/
+    /**************************************************/
+    /**************************************************/
+
     // advertise given ROS topics;
+    // diagnostic statements are aggregated and published once per second, including the ones above;
     position_publisher      = nh.advertise<seneka_msg::dgpsPosition>            (position_topic.c_str(), 1);
-    diagnostics_publisher   = nh.advertise<diagnostic_msgs::DiagnosticArray>    (diagnostics_topic.c_str(), 1);
+
+    diagnostics.setFrameId("dgps_frame_id");
+    diagnostics.start(nh, diagnostics_topic, 1.0);
+
+    if (estimator_rate > 0.0) {
+
+        estimate_publisher  = nh.advertise<seneka_msg::dgpsPosition>            (estimate_topic.c_str(), 1);
+
+        estimator_running   = true;
+        estimator_thread    = boost::thread(boost::bind(&SenekaDgps::runEstimator, this));
+
+    }
 
 }
 
@@ -162,7 +342,17 @@ SenekaDgps::SenekaDgps() {
 /**************************************************/
 
 // destructor;
-SenekaDgps::~SenekaDgps(){}
+SenekaDgps::~SenekaDgps() {
+
+    {
+        boost::mutex::scoped_lock lock(estimator_mutex);
+        estimator_running = false;
+    }
+
+    if (estimator_thread.joinable())
+        estimator_thread.join();
+
+}
 
 /**************************************************/
 /**************************************************/
@@ -175,15 +365,16 @@ SenekaDgps::~SenekaDgps(){}
 // see ROS diagnostics (http://wiki.ros.org/diagnostics and http://docs.ros.org/api/diagnostic_msgs/html/msg/DiagnosticStatus.html);
 void SenekaDgps::extractDiagnostics(Dgps &obj) {
 
-    Dgps::DiagnosticStatement statement;
+    for (size_t i = 0; i < obj.diagnostic_array.size(); i++) {
 
-    for (std::vector<Dgps::DiagnosticStatement>::iterator it = obj.diagnostic_array.begin(); it != obj.diagnostic_array.end(); it++) {
+        const Dgps::DiagnosticStatement & statement = obj.diagnostic_array[i];
 
-        statement = * it;
+        message << statement.message;
 
-        message << statement.diagnostic_message;
+        if (statement.repeats > 0)
+            message << " (repeated " << statement.repeats << " times)";
 
-        switch (statement.diagnostic_flag) {
+        switch (statement.flag) {
 
             case Dgps::DEBUG:
 
@@ -207,7 +398,7 @@ void SenekaDgps::extractDiagnostics(Dgps &obj) {
 
             default:
 
-                message << "No matching ROS verbosity level for message: " << statement.diagnostic_message;
+                message << " (no matching ROS verbosity level)";
                 publishDiagnostics(WARN);
                 break;
 
@@ -225,21 +416,13 @@ void SenekaDgps::extractDiagnostics(Dgps &obj) {
 /**************************************************/
 /**************************************************/
 
-// takes diagnostic statements and publishes them to given topic;
+// takes diagnostic statements, logs them and updates the status of the node;
+// the status is aggregated and published at a fixed rate, see seneka_diagnostics/DiagnosticsAggregator.h;
 // enumerated DiagnosticFlag type for diagnostic statements;
 // see ROS verbosity levels (http://wiki.ros.org/Verbosity Levels);
 // see ROS diagnostics (http://wiki.ros.org/diagnostics and http://docs.ros.org/api/diagnostic_msgs/html/msg/DiagnosticStatus.html);
 void SenekaDgps::publishDiagnostics(DiagnosticFlag flag) {
 
-    // allocates another element in diagnostics array;
-    diagnostics.status.resize(1);
-    
-    // diagnostics.status[0].level  assignment below;
-    diagnostics.header.frame_id     = "dgps_frame_id";
-    diagnostics.header.stamp        = ros::Time::now();
-    diagnostics.status[0].name      = nh.getNamespace();
-    diagnostics.status[0].message   = message.str();
-
     switch(flag) {
 
         case DEBUG:
@@ -250,24 +433,25 @@ void SenekaDgps::publishDiagnostics(DiagnosticFlag flag) {
         case INFO:
 
             ROS_INFO    ("%s", message.str().c_str());
-            diagnostics.status[0].level = 0;
+            diagnostics.setStatus(nh.getNamespace(), DiagnosticsAggregator::OK, message.str());
             break;
 
         case WARN:
 
             ROS_WARN    ("%s", message.str().c_str());
-            diagnostics.status[0].level = 1;
+            diagnostics.setStatus(nh.getNamespace(), DiagnosticsAggregator::WARN, message.str());
             break;
 
         case ERROR:
 
             ROS_ERROR   ("%s", message.str().c_str());
-            diagnostics.status[0].level = 2;
+            diagnostics.setStatus(nh.getNamespace(), DiagnosticsAggregator::ERROR, message.str());
             break;
 
         case FATAL:
 
             ROS_FATAL   ("%s", message.str().c_str());
+            diagnostics.setStatus(nh.getNamespace(), DiagnosticsAggregator::ERROR, message.str());
             break;
 
         default:
@@ -277,8 +461,6 @@ void SenekaDgps::publishDiagnostics(DiagnosticFlag flag) {
 
     }
 
-    diagnostics_publisher.publish(diagnostics);
-
     // this expression clears the stringstream instance "message" after each transmit process;
     // if it doesn't get cleared, every new diagnostic statement will get attached
     // to the existing ones within the object "message", so that it grows and grows...;
@@ -290,14 +472,97 @@ void SenekaDgps::publishDiagnostics(DiagnosticFlag flag) {
 /**************************************************/
 /**************************************************/
 
+// collects latency and rate of the published epochs;
+void SenekaDgps::addEpoch(long gps_msec_of_week, double latency) {
+
+    ros::Time now = ros::Time::now();
+
+    if (epochs == 0)
+        statistics_start = now;
+
+    // gaps of the GPS time (a negative interval is a week rollover);
+    long interval = gps_msec_of_week - last_msec_of_week;
+
+    if (last_msec_of_week >= 0 && interval > 0) {
+
+        if (epoch_interval == 0 || interval < epoch_interval)
+            epoch_interval = interval;
+
+        missed_epochs += (interval + epoch_interval / 2) / epoch_interval - 1;
+
+    }
+
+    last_msec_of_week = gps_msec_of_week;
+
+    epochs++;
+    latency_sum     += latency;
+    latency_max      = std::max(latency_max, latency);
+
+    double elapsed = (now - statistics_start).toSec();
+
+    if (elapsed < statistics_period)
+        return;
+
+    // formatted separately, so that the fixed precision does not stick to the message stream;
+    std::ostringstream statistics;
+
+    statistics << "Positions: " << std::fixed << std::setprecision(1) << (epochs - 1) / elapsed << " Hz, "
+               << missed_epochs << " missed epochs, epoch to publish latency mean " << latency_sum / epochs * 1000.0
+               << " ms, max " << latency_max * 1000.0 << " ms, clock offset " << gps_time.clockOffset() * 1000.0 << " ms";
+
+    message << statistics.str();
+    publishDiagnostics(missed_epochs > 0 ? WARN : INFO);
+
+    // the current epoch starts the next period;
+    statistics_start    = now;
+    epochs              = 1;
+    latency_sum         = latency;
+    latency_max         = latency;
+    missed_epochs       = 0;
+
+}
+
+/**************************************************/
+/**************************************************/
+/**************************************************/
+
 // takes position data from DGPS device and publishes it to given ROS topic;
-void SenekaDgps::publishPosition(Dgps::GpsData gps_data) {
+// both headers are stamped with the epoch of the position instead of the time of publishing,
+// so that the stamps do not depend on the serial round trip and the load of the node;
+void SenekaDgps::publishPosition(Dgps::GpsData gps_data, boost::system_time arrival_time) {
+
+    static const boost::posix_time::ptime unix_epoch(boost::gregorian::date(1970, 1, 1));
+
+    double arrival  = (arrival_time - unix_epoch).total_microseconds() / 1e6;
+    ros::Time stamp = ros::Time(gps_time.stamp(gps_data.gps_msec_of_week, arrival));
+
+    // the host clock is not synchronized to GPS time, the epochs are moved onto it;
+    if (gps_time.synchronized() != clock_synchronized) {
+
+        clock_synchronized = gps_time.synchronized();
+
+        if (!clock_synchronized) {
+
+            message << "Host clock is " << gps_time.clockOffset() << " s off GPS time (limit " << max_clock_offset
+                    << " s)! Time stamps are corrected by this offset, synchronize the host clock for accurate stamps.";
+            publishDiagnostics(WARN);
+
+        }
+
+        else {
+
+            message << "Host clock is synchronized to GPS time again (offset " << gps_time.clockOffset() << " s).";
+            publishDiagnostics(INFO);
+
+        }
+
+    }
 
     position.header.frame_id           = "dgps_frame_id";
-    position.header.stamp              = ros::Time::now();
+    position.header.stamp              = stamp;
 
     position.NavSatFix.header.frame_id = "dgps_frame_id";
-    position.NavSatFix.header.stamp    = ros::Time::now();
+    position.NavSatFix.header.stamp    = stamp;
     position.NavSatFix.latitude        = gps_data.latitude_value;
     position.NavSatFix.longitude       = gps_data.longitude_value;
     position.NavSatFix.altitude        = gps_data.altitude_value;
@@ -331,6 +596,81 @@ void SenekaDgps::publishPosition(Dgps::GpsData gps_data) {
 
     position_publisher.publish(position);
 
+    addEpoch(gps_data.gps_msec_of_week, (ros::Time::now() - stamp).toSec());
+
+    if (estimator_rate > 0.0) {
+
+        double error;
+
+        {
+            boost::mutex::scoped_lock lock(estimator_mutex);
+
+            estimate    = position;
+            error       = estimator.correct(gps_data, position.header.stamp.toSec());
+        }
+
+        if (error >= 0.0) {
+
+            message << "Position estimator corrected by " << error << " m";
+            publishDiagnostics(DEBUG);
+
+        }
+
+    }
+
+}
+
+/**************************************************/
+/**************************************************/
+/**************************************************/
+
+// publishes a predicted position at estimator_rate until the node shuts down;
+// the prediction is stamped with the time it refers to;
+// the covariance is the diagonal east, north, up covariance of PositionEstimator;
+void SenekaDgps::runEstimator() {
+
+    ros::Rate loop_rate(estimator_rate);
+
+    seneka_msg::dgpsPosition        prediction;
+    PositionEstimator::Estimate     state;
+
+    while (ros::ok()) {
+
+        loop_rate.sleep();
+
+        ros::Time now = ros::Time::now();
+
+        {
+            boost::mutex::scoped_lock lock(estimator_mutex);
+
+            if (!estimator_running)
+                break;
+
+            // no fix yet or the latest one is too old;
+            if (!estimator.predict(now.toSec(), state))
+                continue;
+
+            prediction = estimate;
+        }
+
+        prediction.header.stamp                     = now;
+        prediction.NavSatFix.header.stamp           = now;
+        prediction.NavSatFix.latitude               = state.latitude;
+        prediction.NavSatFix.longitude              = state.longitude;
+        prediction.NavSatFix.altitude               = state.altitude;
+
+        for (int i = 0; i < 9; i++)
+            prediction.NavSatFix.position_covariance[i] = 0.0;
+
+        prediction.NavSatFix.position_covariance[0] = state.horizontal_variance;
+        prediction.NavSatFix.position_covariance[4] = state.horizontal_variance;
+        prediction.NavSatFix.position_covariance[8] = state.vertical_variance;
+        prediction.NavSatFix.position_covariance_type = sensor_msgs::NavSatFix::COVARIANCE_TYPE_APPROXIMATED;
+
+        estimate_publisher.publish(prediction);
+
+    }
+
 }
 
 /**************************************************/
@@ -0,0 +1,293 @@
+/*!
+*****************************************************************
+* dgpsNodeBenchmark.cpp
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_dgps
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description: The seneka_dgps package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* It implements a GNU/Linux driver for the Trimble BD982 GNSS Receiver Module as well as a ROS publisher node "DGPS", which acts as a wrapper for the driver.
+* The ROS node "DGPS" publishes GPS data gathered by the DGPS device driver.
+* This package might work with other hardware and can be used for other purposes, however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+// End-to-end benchmark of the node "DGPS" against an emulated receiver (see ReceiverEmulator.h):
+// the emulator links its pty to a fixed port name, the node is started separately on that port,
+// e.g. by "roslaunch seneka_node_bringup dgps_benchmark.launch". Three phases are measured:
+//
+// clean:   sustained rate of the published positions, latency from the last byte of a position
+//          record on the serial line and from its epoch to the reception here, and the error of
+//          the time stamps against the epochs;
+// faults:  the same with NAK, bad checksums, split packets and missing replies;
+// outage:  the receiver is silent for a while, recovery time is the time from its end until
+//          the next published position.
+//
+// parameters (private): link, duration [s], outage [s], fault_probability, stream_rate [Hz],
+// reply_delay [ms], baud [Bd]; a stream_rate above 0 needs the node in "streaming" mode.
+
+#include <ros/ros.h>
+#include <seneka_msg/dgpsPosition.h>
+
+#include <seneka_dgps/ReceiverEmulator.h>
+
+#include <stdio.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+/*********************************************************/
+/*************** position message monitor ***************/
+/*********************************************************/
+
+struct Monitor {
+
+    ReceiverEmulator *          emulator;
+
+    boost::mutex                mutex;
+    boost::condition_variable   condition;
+    unsigned long               positions;
+    std::vector<double>         stamp_errors;           // [] = ms; time stamp minus epoch
+    std::vector<double>         epoch_latencies;        // [] = ms; epoch to reception
+    std::vector<double>         receive_latencies;      // [] = ms; last byte sent to reception
+    boost::system_time          last_receive_time;
+
+    // seconds since 1970 of a boost time, comparable to ros::Time without simulated time;
+    static double toSec(const boost::system_time & time) {
+
+        return (time - boost::posix_time::ptime(boost::gregorian::date(1970, 1, 1))).total_microseconds() / 1e6;
+
+    }
+
+    void reset() {
+
+        boost::mutex::scoped_lock lock(mutex);
+        positions = 0;
+        stamp_errors.clear();
+        epoch_latencies.clear();
+        receive_latencies.clear();
+
+    }
+
+    void receive(const seneka_msg::dgpsPosition::ConstPtr & position) {
+
+        boost::system_time now = boost::get_system_time();
+        boost::system_time epoch_time, send_time;
+
+        bool known = emulator->sendTime(position->gps_msec_of_week, epoch_time, send_time);
+
+        {
+            boost::mutex::scoped_lock lock(mutex);
+
+            positions++;
+            last_receive_time = now;
+
+            if (known) {
+                stamp_errors.push_back((position->header.stamp.toSec() - toSec(epoch_time)) * 1000.0);
+                epoch_latencies.push_back((now - epoch_time).total_microseconds() / 1000.0);
+                receive_latencies.push_back((now - send_time).total_microseconds() / 1000.0);
+            }
+        }
+
+        condition.notify_all();
+
+    }
+
+    // waits until a position has been received after time, returns its reception time;
+    bool waitForPosition(const boost::system_time & time, int timeout, boost::system_time & receive_time) {
+
+        boost::system_time deadline = boost::get_system_time() + boost::posix_time::milliseconds(timeout);
+        boost::mutex::scoped_lock lock(mutex);
+
+        while (last_receive_time.is_not_a_date_time() || last_receive_time <= time) {
+
+            if (!ros::ok() || boost::get_system_time() >= deadline)
+                return false;
+
+            // wakes up regularly to notice a shutdown;
+            condition.timed_wait(lock, std::min(deadline, boost::get_system_time() + boost::posix_time::milliseconds(100)));
+
+        }
+
+        receive_time = last_receive_time;
+
+        return true;
+
+    }
+
+};
+
+static void printLatencies(const char * name, std::vector<double> latencies) {
+
+    if (latencies.empty()) {
+        printf("  %-22s no matching records\n", name);
+        return;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    size_t n = latencies.size();
+
+    printf("  %-22s min %6.2f  median %6.2f  p90 %6.2f  p99 %6.2f  max %6.2f ms\n", name,
+           latencies[0], latencies[n / 2], latencies[n * 9 / 10], latencies[n * 99 / 100], latencies[n - 1]);
+
+}
+
+// measures rate and latency for duration seconds;
+static void measure(const char * phase, Monitor & monitor, ReceiverEmulator & emulator, double duration) {
+
+    ReceiverEmulator::Statistics before = emulator.getStatistics();
+    monitor.reset();
+
+    boost::system_time end = boost::get_system_time() + boost::posix_time::milliseconds((long) (duration * 1000));
+
+    while (ros::ok() && boost::get_system_time() < end)
+        boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+
+    ReceiverEmulator::Statistics after = emulator.getStatistics();
+
+    boost::mutex::scoped_lock lock(monitor.mutex);
+
+    printf("%s:\n", phase);
+    printf("  %lu positions in %.1f s: %.2f Hz\n", monitor.positions, duration, monitor.positions / duration);
+    printf("  receiver: %lu requests, %lu records, %lu NAK, %lu bad checksums, %lu split, %lu dropped, %lu invalid requests\n",
+           after.requests - before.requests, after.records - before.records, after.naks - before.naks,
+           after.bad_checksums - before.bad_checksums, after.splits - before.splits, after.drops - before.drops,
+           after.invalid_requests - before.invalid_requests);
+
+    if (after.records > before.records)
+        printf("  published %.1f %% of the valid records\n", 100.0 * monitor.positions / (after.records - before.records));
+
+    printLatencies("time stamp error", monitor.stamp_errors);
+    printLatencies("epoch to reception", monitor.epoch_latencies);
+    printLatencies("record to reception", monitor.receive_latencies);
+
+}
+
+int main(int argc, char** argv) {
+
+    ros::init(argc, argv, "dgps_node_benchmark");
+
+    ros::NodeHandle nh;
+    ros::NodeHandle pnh("~");
+
+    std::string link;
+    double      duration, outage, fault_probability, stream_rate;
+    int         reply_delay, baud;
+
+    pnh.param("link",               link,               std::string("/tmp/ttyDGPS"));
+    pnh.param("duration",           duration,           20.0);
+    pnh.param("outage",             outage,             5.0);
+    pnh.param("fault_probability",  fault_probability,  0.05);
+    pnh.param("stream_rate",        stream_rate,        0.0);
+    pnh.param("reply_delay",        reply_delay,        5);
+    pnh.param("baud",               baud,               38400);
+
+    ReceiverEmulator::Config clean;
+    clean.reply_delay   = reply_delay;
+    clean.baud_rate     = baud;
+    clean.stream_rate   = stream_rate;
+
+    ReceiverEmulator::Config faults = clean;
+    faults.nak_probability          = fault_probability;
+    faults.checksum_probability     = fault_probability;
+    faults.split_probability        = fault_probability;
+    faults.drop_probability         = fault_probability;
+    faults.position_noise           = 0.5;
+
+    ReceiverEmulator emulator(clean);
+
+    if (!emulator.open(link)) {
+        printf("could not open the emulator on %s\n", link.c_str());
+        return 1;
+    }
+
+    printf("emulated receiver on %s (%s), %d Bd, reply delay %d ms, %s\n", link.c_str(), emulator.getDeviceName().c_str(),
+           baud, reply_delay, stream_rate > 0.0 ? "streaming" : "polling");
+
+    Monitor monitor;
+    monitor.emulator = &emulator;
+    monitor.reset();
+
+    ros::Subscriber subscriber = nh.subscribe("/position", 100, &Monitor::receive, &monitor);
+
+    ros::AsyncSpinner spinner(1);
+    spinner.start();
+
+    // the node opens the port and checks the connection first;
+    boost::system_time receive_time;
+
+    if (!monitor.waitForPosition(boost::get_system_time(), 60000, receive_time)) {
+        printf("no position published within 60 s, is the node running on %s?\n", link.c_str());
+        return 1;
+    }
+
+    measure("clean", monitor, emulator, duration);
+
+    emulator.setConfig(faults);
+    measure("faults", monitor, emulator, duration);
+    emulator.setConfig(clean);
+
+    // outage and recovery;
+    if (monitor.waitForPosition(boost::get_system_time(), 10000, receive_time)) {
+
+        emulator.interrupt((int) (outage * 1000));
+        boost::system_time outage_end = boost::get_system_time() + boost::posix_time::milliseconds((long) (outage * 1000));
+
+        printf("outage of %.1f s:\n", outage);
+
+        if (monitor.waitForPosition(outage_end, (int) (outage * 1000) + 30000, receive_time))
+            printf("  recovered %.1f ms after the end of the outage\n", (receive_time - outage_end).total_microseconds() / 1000.0);
+        else
+            printf("  no position within 30 s after the end of the outage\n");
+
+    }
+
+    spinner.stop();
+    emulator.close();
+
+    return 0;
+
+}
@@ -108,6 +108,7 @@ int main(int argc, char** argv) {
 
         cSenekaDgps.message << "Establishing serial connection finally failed. Device is not available.";
         cSenekaDgps.publishDiagnostics(SenekaDgps::ERROR);
+        cSenekaDgps.flushDiagnostics();
 
         return 0;
 
@@ -150,6 +151,7 @@ int main(int argc, char** argv) {
 
         cSenekaDgps.message << "Testing the communication link finally failed. Device is not available.";
         cSenekaDgps.publishDiagnostics(SenekaDgps::ERROR);
+        cSenekaDgps.flushDiagnostics();
 
         return 0;
 
@@ -159,8 +161,43 @@ int main(int argc, char** argv) {
     /*************** main program loop ***************/
     /*************************************************/
 
+    // streaming mode: the receiver sends position records on its own,
+    // each one is parsed and published as soon as it arrives;
+    if (cSenekaDgps.isStreaming()) {
+
+        cSenekaDgps.message << "Initiate publishing of streamed DGPS data...";
+        cSenekaDgps.publishDiagnostics(SenekaDgps::INFO);
+
+        while (cSenekaDgps.nh.ok()) {
+
+            if (cDgps.receiveDgpsData(1000)) {
+
+                cSenekaDgps.extractDiagnostics(cDgps);
+
+                cSenekaDgps.publishPosition(cDgps.getPosition(), cDgps.getArrivalTime());
+
+            }
+
+            else {
+
+                cSenekaDgps.extractDiagnostics(cDgps);
+
+            }
+
+            ros::spinOnce();
+
+        }
+
+        return 0;
+
+    }
+
     ros::Rate loop_rate(cSenekaDgps.getRate());
 
+    // all record types are requested at once in each cycle;
+    cDgps.setRecordTypes(cSenekaDgps.getRecordTypes());
+    cSenekaDgps.extractDiagnostics(cDgps);
+
     cSenekaDgps.message << "Initiate continuous requesting and publishing of DGPS data...";
     cSenekaDgps.publishDiagnostics(SenekaDgps::INFO);
 
@@ -174,7 +211,7 @@ int main(int argc, char** argv) {
             cSenekaDgps.extractDiagnostics(cDgps);
 
             // gathering data from DGPS instance and publishing it to given ROS topic;
-            cSenekaDgps.publishPosition(cDgps.getPosition());
+            cSenekaDgps.publishPosition(cDgps.getPosition(), cDgps.getArrivalTime());
 
         }
 
@@ -0,0 +1,152 @@
+/*!
+*****************************************************************
+* StatementRing.h
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_diagnostics
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description: The seneka_diagnostics package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* It holds the diagnostics handling shared by the sensor drivers: bounded statement buffers and aggregated publishing at a fixed low rate.
+* This package might work with other hardware and can be used for other purposes, however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+
+#ifndef STATEMENT_RING_H_
+#define STATEMENT_RING_H_
+
+/****************************************/
+/*************** includes ***************/
+/****************************************/
+
+#include <stddef.h>
+#include <string>
+
+/***************************************************/
+/*************** StatementRing class ***************/
+/***************************************************/
+
+// fixed size ring buffer for diagnostic statements of a driver, collected until its node takes them out;
+// if the ring is full, the oldest statement is overwritten in O(1) and counted as dropped;
+// a statement which repeats the latest one (same flag and message) only increments its repeat counter,
+// so a failure which is reported every cycle occupies a single slot;
+// the slots keep their string memory, so pushing does not allocate once the ring has been filled;
+// Flag: level type of the statements (e.g. Dgps::DiagnosticFlag);
+template <typename Flag, size_t CAPACITY = 100>
+class StatementRing {
+
+    public:
+
+        struct Statement {
+
+            std::string     message;
+            Flag            flag;
+            unsigned long   repeats;    // number of identical statements merged into this one
+
+        };
+
+        static const size_t capacity = CAPACITY;
+
+        StatementRing() {
+
+            clear();
+            dropped_ = 0;
+
+        }
+
+        void push(Flag flag, const std::string & message) {
+
+            if (size_ > 0) {
+
+                Statement & latest = slot(size_ - 1);
+
+                if (latest.flag == flag && latest.message == message) {
+                    latest.repeats++;
+                    return;
+                }
+
+            }
+
+            if (size_ == CAPACITY) {
+                first_ = (first_ + 1) % CAPACITY;
+                size_--;
+                dropped_++;
+            }
+
+            Statement & statement = slot(size_);
+            statement.message.assign(message);
+            statement.flag      = flag;
+            statement.repeats   = 0;
+            size_++;
+
+        }
+
+        // statements in order of arrival, 0 is the oldest one;
+        size_t size() const                                 {return size_;}
+        bool empty() const                                  {return size_ == 0;}
+        const Statement & operator[](size_t i) const        {return ring_[(first_ + i) % CAPACITY];}
+
+        // removes all statements, e.g. after they have been published;
+        void clear() {
+
+            first_  = 0;
+            size_   = 0;
+
+        }
+
+        // statements which have been overwritten before they were taken out;
+        unsigned long dropped() const                       {return dropped_;}
+
+    private:
+
+        Statement & slot(size_t i)                          {return ring_[(first_ + i) % CAPACITY];}
+
+        Statement       ring_[CAPACITY];
+        size_t          first_;
+        size_t          size_;
+        unsigned long   dropped_;
+
+};
+
+#endif // STATEMENT_RING_H_
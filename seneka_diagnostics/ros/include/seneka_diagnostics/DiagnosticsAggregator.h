@@ -0,0 +1,241 @@
+/*!
+*****************************************************************
+* DiagnosticsAggregator.h
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_diagnostics
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description: The seneka_diagnostics package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* It holds the diagnostics handling shared by the sensor drivers: bounded statement buffers and aggregated publishing at a fixed low rate.
+* This package might work with other hardware and can be used for other purposes, however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+
+#ifndef DIAGNOSTICS_AGGREGATOR_H_
+#define DIAGNOSTICS_AGGREGATOR_H_
+
+/****************************************/
+/*************** includes ***************/
+/****************************************/
+
+#include <ros/ros.h>
+#include <diagnostic_msgs/DiagnosticArray.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+#include <sstream>
+#include <string>
+
+/***********************************************************/
+/*************** DiagnosticsAggregator class ***************/
+/***********************************************************/
+
+// collects the status of the components of a node (e.g. a sensor or a joint) and publishes all of them
+// in a single DiagnosticArray at a fixed low rate, independent of how often the status is updated;
+// setStatus() only stores level and message, so it can be called in every cycle of the data path;
+// the worst status of a period is published, a short error is not hidden by a following OK;
+// identical warnings and errors of a period are published once with their number of occurrences;
+// publishing is done by a ros::Timer, i.e. by ros::spinOnce() of the node; flush() publishes at once;
+// copies share the same state, so the aggregator can be a member of a node class which is copied;
+class DiagnosticsAggregator {
+
+    public:
+
+        // levels of diagnostic_msgs::DiagnosticStatus;
+        enum Level {
+
+            OK      = diagnostic_msgs::DiagnosticStatus::OK,
+            WARN    = diagnostic_msgs::DiagnosticStatus::WARN,
+            ERROR   = diagnostic_msgs::DiagnosticStatus::ERROR
+
+        };
+
+        DiagnosticsAggregator() : state_(new State) {}
+
+        // advertises the topic and starts publishing every period seconds;
+        // the status set before is published with the first period;
+        void start(ros::NodeHandle & nh, const std::string & topic = "/diagnostics", double period = 1.0) {
+
+            boost::mutex::scoped_lock lock(state_->mutex);
+
+            state_->publisher   = nh.advertise<diagnostic_msgs::DiagnosticArray>(topic, 1);
+            state_->timer       = nh.createTimer(ros::Duration(period), &State::publishTimer, state_.get());
+
+        }
+
+        void setFrameId(const std::string & frame_id) {
+
+            boost::mutex::scoped_lock lock(state_->mutex);
+            state_->diagnostics.header.frame_id = frame_id;
+
+        }
+
+        // stores the current status of a component;
+        void setStatus(const std::string & name, unsigned char level, const std::string & message) {
+
+            boost::mutex::scoped_lock lock(state_->mutex);
+
+            Entry & entry = state_->entries[name];
+
+            entry.level = level;
+            if (entry.message != message)
+                entry.message = message;
+
+            if (entry.count > 0 && level < entry.worst_level) {
+                entry.count++;
+                return;
+            }
+
+            // a statement of the same or a higher level replaces the one to be published;
+            if (entry.count > 0 && level == entry.worst_level && message == entry.worst_message) {
+                entry.repeats++;
+            }
+            else {
+                entry.worst_level = level;
+                entry.worst_message = message;
+                entry.repeats = 0;
+            }
+
+            entry.count++;
+
+        }
+
+        // publishes the aggregated status immediately, e.g. before the node shuts down;
+        void flush() {
+
+            boost::mutex::scoped_lock lock(state_->mutex);
+            state_->publish();
+
+        }
+
+    private:
+
+        struct Entry {
+
+            Entry() : level(OK), count(0), worst_level(OK), repeats(0) {}
+
+            // latest status;
+            unsigned char   level;
+            std::string     message;
+
+            // worst status since the last publishing;
+            unsigned long   count;          // setStatus() calls
+            unsigned char   worst_level;
+            std::string     worst_message;
+            unsigned long   repeats;        // identical worst statements
+
+        };
+
+        struct State {
+
+            boost::mutex                            mutex;
+            ros::Publisher                          publisher;
+            ros::Timer                              timer;
+            std::map<std::string, Entry>            entries;
+            diagnostic_msgs::DiagnosticArray        diagnostics;
+
+            void publishTimer(const ros::TimerEvent &) {
+
+                boost::mutex::scoped_lock lock(mutex);
+                publish();
+
+            }
+
+            // mutex has to be locked;
+            void publish() {
+
+                if (!publisher || entries.empty())
+                    return;
+
+                diagnostics.header.stamp = ros::Time::now();
+                diagnostics.status.resize(entries.size());
+
+                size_t i = 0;
+
+                for (std::map<std::string, Entry>::iterator it = entries.begin(); it != entries.end(); it++, i++) {
+
+                    Entry & entry = it->second;
+                    diagnostic_msgs::DiagnosticStatus & status = diagnostics.status[i];
+
+                    status.name = it->first;
+
+                    // without an update in this period, the latest status is repeated;
+                    if (entry.count == 0) {
+                        status.level    = entry.level;
+                        status.message  = entry.message;
+                        status.values.clear();
+                        continue;
+                    }
+
+                    status.level    = entry.worst_level;
+                    status.message  = entry.worst_message;
+                    status.values.clear();
+
+                    // number of identical warnings and errors of the period;
+                    if (entry.worst_level != OK) {
+                        std::ostringstream occurrences;
+                        occurrences << entry.repeats + 1;
+                        status.values.resize(1);
+                        status.values[0].key    = "occurrences";
+                        status.values[0].value  = occurrences.str();
+                    }
+
+                    entry.count = 0;
+
+                }
+
+                publisher.publish(diagnostics);
+
+            }
+
+        };
+
+        boost::shared_ptr<State> state_;
+
+};
+
+#endif // DIAGNOSTICS_AGGREGATOR_H_
@@ -0,0 +1,202 @@
+/*!
+*****************************************************************
+* RowBandPool.h
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_image_processing
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description:
+* The seneka_image_processing package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* This package might work with other hardware and can be used for other purposes,
+* however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef ROW_BAND_POOL_H_
+#define ROW_BAND_POOL_H_
+
+/*******************************************/
+/*************** RowBandPool ***************/
+/*******************************************/
+
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+
+// Splits an image into row bands and processes them in parallel on a set of
+// persistent worker threads. The calling thread processes the first band
+// itself, so a pool of n threads only starts n - 1 workers and a pool of one
+// thread runs everything in the caller without any synchronization.
+class RowBandPool {
+
+  public:
+
+    // band function, processes the rows [begin, end); it must not throw
+    typedef boost::function<void (int begin, int end)> BandFunction;
+
+    // threads: number of threads working on a frame including the caller, 0 uses one thread per core;
+    RowBandPool(unsigned int threads = 0) {
+
+      if(threads == 0)
+        threads = boost::thread::hardware_concurrency();
+
+      threads_    = threads > 0 ? threads : 1;
+      band_       = NULL;
+      rows_       = 0;
+      generation_ = 0;
+      pending_    = 0;
+      running_    = true;
+
+      for(unsigned int i = 1; i < threads_; i++)
+        workers_.create_thread(boost::bind(&RowBandPool::work, this, i));
+
+    }
+
+    ~RowBandPool() {
+
+      {
+        boost::mutex::scoped_lock lock(mutex_);
+        running_ = false;
+      }
+      start_condition_.notify_all();
+      workers_.join_all();
+
+    }
+
+    unsigned int threads() const { return threads_; }
+
+    // calls band(begin, end) for consecutive row bands which cover [0, rows);
+    // returns as soon as all bands are processed;
+    void run(int rows, const BandFunction& band) {
+
+      if(threads_ == 1 || rows < (int) threads_) {
+        if(rows > 0)
+          band(0, rows);
+        return;
+      }
+
+      // a single frame at a time, the workers only know one band function
+      boost::mutex::scoped_lock run_lock(run_mutex_);
+
+      {
+        boost::mutex::scoped_lock lock(mutex_);
+        band_    = &band;
+        rows_    = rows;
+        pending_ = threads_ - 1;
+        generation_++;
+      }
+      start_condition_.notify_all();
+
+      runBand(0);
+
+      boost::mutex::scoped_lock lock(mutex_);
+      while(pending_ > 0)
+        done_condition_.wait(lock);
+      band_ = NULL;
+
+    }
+
+  private:
+
+    // worker thread: waits for the next frame and processes its band
+    void work(unsigned int index) {
+
+      unsigned long seen = 0;
+
+      while(true) {
+
+        {
+          boost::mutex::scoped_lock lock(mutex_);
+          while(running_ && generation_ == seen)
+            start_condition_.wait(lock);
+
+          if(!running_)
+            return;
+
+          seen = generation_;
+        }
+
+        runBand(index);
+
+        {
+          boost::mutex::scoped_lock lock(mutex_);
+          if(--pending_ == 0)
+            done_condition_.notify_one();
+        }
+
+      }
+
+    }
+
+    // band index of threads_ equally sized bands
+    void runBand(unsigned int index) {
+
+      int begin = (int) ((long long) rows_ * index / threads_);
+      int end   = (int) ((long long) rows_ * (index + 1) / threads_);
+
+      if(end > begin)
+        (*band_)(begin, end);
+
+    }
+
+    unsigned int threads_;
+
+    boost::thread_group workers_;
+    boost::mutex mutex_;
+    boost::mutex run_mutex_;
+    boost::condition_variable start_condition_;
+    boost::condition_variable done_condition_;
+
+    // current frame, guarded by mutex_
+    const BandFunction* band_;
+    int rows_;
+    unsigned long generation_;
+    unsigned int pending_;
+    bool running_;
+
+};
+
+#endif // ROW_BAND_POOL_H_
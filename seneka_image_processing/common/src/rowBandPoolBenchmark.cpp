@@ -0,0 +1,156 @@
+/*!
+*****************************************************************
+* rowBandPoolBenchmark.cpp
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_image_processing
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description:
+* The seneka_image_processing package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* This package might work with other hardware and can be used for other purposes,
+* however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+// Measures how the row band pool scales with the number of threads. Each
+// frame is converted from UYVY to RGB, which is the conversion done by the
+// Sony camera node.
+//
+// usage: row_band_pool_benchmark [width height [frames [max_threads]]]
+
+#include <seneka_image_processing/RowBandPool.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+struct Frame {
+  int width;
+  int height;
+  std::vector<unsigned char> yuv;
+  std::vector<unsigned char> rgb;
+};
+
+static inline unsigned char clamp(int value) {
+  return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+// fixed-point BT.601 conversion of the rows [begin, end)
+void convertRows(Frame* frame, int begin, int end) {
+
+  for(int y = begin; y < end; y++) {
+
+    const unsigned char* src = &frame->yuv[(size_t) y * frame->width * 2];
+    unsigned char* dst = &frame->rgb[(size_t) y * frame->width * 3];
+
+    for(int x = 0; x < frame->width; x += 2, src += 4, dst += 6) {
+
+      int u = src[0] - 128;
+      int v = src[2] - 128;
+      int r = (359 * v) >> 8;
+      int g = (88 * u + 183 * v) >> 8;
+      int b = (454 * u) >> 8;
+
+      dst[0] = clamp(src[1] + r);
+      dst[1] = clamp(src[1] - g);
+      dst[2] = clamp(src[1] + b);
+      dst[3] = clamp(src[3] + r);
+      dst[4] = clamp(src[3] - g);
+      dst[5] = clamp(src[3] + b);
+    }
+  }
+
+}
+
+int main(int argc, char** argv) {
+
+  Frame frame;
+  frame.width  = argc > 2 ? atoi(argv[1]) : 1920;
+  frame.height = argc > 2 ? atoi(argv[2]) : 1080;
+  int frames   = argc > 3 ? atoi(argv[3]) : 200;
+  unsigned int max_threads = argc > 4 ? atoi(argv[4]) : boost::thread::hardware_concurrency();
+
+  if(frame.width <= 0 || frame.width % 2 != 0 || frame.height <= 0 || frames <= 0) {
+    printf("usage: %s [width height [frames [max_threads]]]\n", argv[0]);
+    return 1;
+  }
+  if(max_threads == 0)
+    max_threads = 1;
+
+  frame.yuv.resize((size_t) frame.width * frame.height * 2);
+  frame.rgb.resize((size_t) frame.width * frame.height * 3);
+  for(size_t i = 0; i < frame.yuv.size(); i++)
+    frame.yuv[i] = (unsigned char) (i * 7 + (i >> 11));
+
+  RowBandPool::BandFunction band = boost::bind(&convertRows, &frame, _1, _2);
+
+  printf("%dx%d, %d frames\n", frame.width, frame.height, frames);
+  printf("threads   ms/frame   speedup\n");
+
+  double single = 0;
+  for(unsigned int threads = 1; threads <= max_threads; threads++) {
+
+    RowBandPool pool(threads);
+
+    // warm up the workers and the caches
+    for(int i = 0; i < 10; i++)
+      pool.run(frame.height, band);
+
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    for(int i = 0; i < frames; i++)
+      pool.run(frame.height, band);
+    boost::posix_time::time_duration elapsed = boost::posix_time::microsec_clock::universal_time() - start;
+
+    double ms = elapsed.total_microseconds() / 1000.0 / frames;
+    if(threads == 1)
+      single = ms;
+
+    printf("%7u   %8.3f   %7.2f\n", threads, ms, single / ms);
+  }
+
+  return 0;
+
+}
@@ -0,0 +1,249 @@
+/*!
+*****************************************************************
+* LineFramer.h
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_serial
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description: The seneka_serial package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* It holds the serial port handling shared by the sensor drivers: a single event loop thread for all ports, native port configuration and message framing.
+* This package might work with other hardware and can be used for other purposes, however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+
+#ifndef LINE_FRAMER_H_
+#define LINE_FRAMER_H_
+
+/****************************************/
+/*************** includes ***************/
+/****************************************/
+
+#include <stddef.h>
+#include <cstring>
+#include <string>
+
+/************************************************/
+/*************** LineFramer class ***************/
+/************************************************/
+
+// incremental framer for line based ASCII protocols (e.g. NMEA 0183 sentences);
+// received bytes are appended to a ring buffer in any chunking, complete lines are taken out one by one;
+// a line is terminated by LF, a preceding CR is removed, empty lines are skipped;
+// with a start character (e.g. '$' for NMEA 0183), a line begins at the last start character before its LF,
+// bytes in front of it (e.g. the rest of a sentence received partially after opening the port) are discarded;
+// a line which exceeds max_line_length is discarded as well, up to its LF (or the next start character),
+// so that its remainder is not taken as a line of its own; the same holds for a line whose beginning was
+// dropped because the ring buffer was full;
+class LineFramer {
+
+    public:
+
+        struct Statistics {
+
+            unsigned long lines;
+            unsigned long discarded_bytes;      // bytes outside of lines
+            unsigned long overlong_lines;
+            unsigned long overflows;            // bytes lost because the ring buffer was full
+
+        };
+
+        // size of the ring buffer, has to be a power of 2;
+        static const size_t capacity = 1024;
+
+        // start: start character of a line, 0 if lines have none;
+        LineFramer(char start = 0, size_t max_line_length = 256) : start_(start), max_line_length_(max_line_length) {
+
+            reset();
+
+        }
+
+        // drops all buffered bytes;
+        void reset() {
+
+            read_ = 0;
+            size_ = 0;
+            scanned_ = 0;
+            skipping_ = false;
+            line_.clear();
+            std::memset(&statistics_, 0, sizeof(statistics_));
+
+        }
+
+        // appends received bytes; if the ring buffer is full, the oldest bytes are dropped;
+        void push(const unsigned char * data, size_t size) {
+
+            for (size_t i = 0; i < size; i++) {
+
+                if (size_ == capacity) {
+
+                    // the rest of the line is useless without its beginning;
+                    skipping_ = at(0) != '\n';
+                    consume(1);
+                    scanned_ = 0;
+                    statistics_.overflows++;
+
+                }
+
+                ring_[(read_ + size_) & (capacity - 1)] = data[i];
+                size_++;
+
+            }
+
+        }
+
+        // processes the buffered bytes up to the next complete line, returns false if there is none;
+        // bytes of an incomplete line stay in the ring buffer until the next push;
+        bool next() {
+
+            while (scanned_ < size_) {
+
+                char byte = at(scanned_);
+
+                // remainder of a discarded line, up to its LF or the start character of the next line;
+                if (skipping_) {
+
+                    if (start_ != 0 && byte == start_) {
+                        skipping_ = false;
+                        continue;
+                    }
+
+                    statistics_.discarded_bytes++;
+                    consume(1);
+
+                    if (byte == '\n')
+                        skipping_ = false;
+
+                    continue;
+
+                }
+
+                if (byte == '\n') {
+
+                    size_t length = scanned_;
+                    if (length > 0 && at(length - 1) == '\r')
+                        length--;
+
+                    // without a start character, the bytes are not part of a line;
+                    bool valid = length > 0 && (start_ == 0 || at(0) == start_);
+
+                    if (valid) {
+                        line_.resize(length);
+                        for (size_t i = 0; i < length; i++)
+                            line_[i] = at(i);
+                        statistics_.lines++;
+                    }
+                    else {
+                        statistics_.discarded_bytes += scanned_ + 1;
+                    }
+
+                    consume(scanned_ + 1);
+                    scanned_ = 0;
+
+                    if (valid)
+                        return true;
+
+                    continue;
+
+                }
+
+                // a line starts at its start character, everything in front of it is dropped;
+                if (start_ != 0 && byte == start_ && scanned_ > 0) {
+                    statistics_.discarded_bytes += scanned_;
+                    consume(scanned_);
+                    scanned_ = 0;
+                }
+
+                scanned_++;
+
+                if (scanned_ > max_line_length_) {
+                    statistics_.discarded_bytes += scanned_;
+                    statistics_.overlong_lines++;
+                    consume(scanned_);
+                    scanned_ = 0;
+                    skipping_ = true;
+                }
+
+            }
+
+            return false;
+
+        }
+
+        // last line returned by next(), without line terminator;
+        const std::string & line() const            {return line_;}
+
+        const Statistics & statistics() const       {return statistics_;}
+
+    private:
+
+        char at(size_t i) const {
+
+            return ring_[(read_ + i) & (capacity - 1)];
+
+        }
+
+        void consume(size_t n) {
+
+            read_ = (read_ + n) & (capacity - 1);
+            size_ -= n;
+
+        }
+
+        char            start_;
+        size_t          max_line_length_;
+
+        char            ring_[capacity];
+        size_t          read_;      // index of the first buffered byte
+        size_t          size_;      // number of buffered bytes
+        size_t          scanned_;   // bytes of the current line which have been examined
+        bool            skipping_;  // the current line is discarded up to its end
+
+        std::string     line_;
+
+        Statistics      statistics_;
+
+};
+
+#endif // LINE_FRAMER_H_
@@ -0,0 +1,443 @@
+/*!
+*****************************************************************
+* SerialPort.h
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_serial
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description: The seneka_serial package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* It holds the serial port handling shared by the sensor drivers: a single event loop thread for all ports, native port configuration and message framing.
+* This package might work with other hardware and can be used for other purposes, however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+
+#ifndef SERIAL_PORT_H_
+#define SERIAL_PORT_H_
+
+/****************************************/
+/*************** includes ***************/
+/****************************************/
+
+#include <seneka_serial/SerialReactor.h>
+
+#include <boost/asio/placeholders.hpp>
+#include <boost/asio/serial_port.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+
+#include <string>
+#include <errno.h>
+#include <termios.h>
+#include <sys/file.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+
+/************************************************/
+/*************** SerialPort class ***************/
+/************************************************/
+
+// serial port which reads asynchronously in the thread of a SerialReactor;
+// every received chunk of bytes is handed to the receive callback as soon as the read returns,
+// the owner feeds it into a framer (e.g. LineFramer.h) and handles the complete messages in the callback;
+// the port is configured natively with termios: raw mode, 8 data bits, no parity, one stop bit, no flow control;
+// writes block the calling thread until the reactor thread has passed the bytes to the driver;
+// works with pseudo-terminals as well, so drivers can be tested against a pty pair;
+// the delay from a received byte to the callback can be measured with serial_latency_probe (see common/src/serialLatencyProbe.cpp);
+class SerialPort {
+
+    public:
+
+        // called by the reactor thread for every received chunk; must not throw;
+        typedef boost::function<void (const unsigned char * data, size_t size)> ReceiveCallback;
+
+        // called by the reactor thread if reading fails (e.g. the device was unplugged), no further data is received;
+        typedef boost::function<void (const boost::system::error_code & ec)> ErrorCallback;
+
+        // options of open();
+        enum Flags {
+
+            // asks the driver to pass received bytes on at once (ASYNC_LOW_LATENCY): USB serial adapters
+            // otherwise collect bytes for their latency timer (16 ms for FTDI chips) before they are delivered;
+            // not supported by every driver (e.g. ptys), open() does not fail in this case, see lowLatency();
+            LOW_LATENCY = 1,
+
+            // locks the device, opening it a second time fails while the port is open (TIOCEXCL and flock);
+            EXCLUSIVE   = 2
+
+        };
+
+        static const size_t read_buffer_size = 256;
+
+        SerialPort(SerialReactor & reactor = SerialReactor::shared()) : reactor_(reactor), port_(reactor.ioService()) {
+
+            open_           = false;
+            reading_        = false;
+            closing_        = false;
+            low_latency_    = false;
+            exclusive_      = false;
+            writing_        = false;
+            write_size_     = 0;
+
+        }
+
+        ~SerialPort() {
+
+            close();
+
+        }
+
+        // opens and configures the port and starts reading;
+        // a port which is already open is closed first;
+        bool open(const std::string &       device,
+                  int                       baud_rate,
+                  const ReceiveCallback &   receive,
+                  const ErrorCallback &     error,
+                  boost::system::error_code & ec,
+                  int                       flags = LOW_LATENCY | EXCLUSIVE) {
+
+            close();
+
+            port_.open(device, ec);
+            if (ec)
+                return false;
+
+            exclusive_ = (flags & EXCLUSIVE) != 0;
+
+            if (exclusive_ && !lock(port_.native_handle(), ec)) {
+                boost::system::error_code ignored;
+                port_.close(ignored);
+                return false;
+            }
+
+            if (!configure(port_.native_handle(), baud_rate, ec)) {
+                boost::system::error_code ignored;
+                if (exclusive_)
+                    ioctl(port_.native_handle(), TIOCNXCL);
+                port_.close(ignored);
+                return false;
+            }
+
+            low_latency_ = (flags & LOW_LATENCY) && setLowLatency(port_.native_handle());
+
+            boost::mutex::scoped_lock lock(mutex_);
+
+            receive_    = receive;
+            error_      = error;
+            open_       = true;
+            reading_    = true;
+            closing_    = false;
+
+            // all operations on the port object are done by the reactor thread;
+            reactor_.ioService().post(boost::bind(&SerialPort::startRead, this));
+
+            return true;
+
+        }
+
+        // stops reading and closes the port; no callback is running or called anymore when it returns;
+        // must not be called by the callbacks of this port;
+        void close() {
+
+            boost::mutex::scoped_lock lock(mutex_);
+
+            if (!open_)
+                return;
+
+            closing_ = true;
+            reactor_.ioService().post(boost::bind(&SerialPort::closePort, this));
+
+            while (open_ || reading_ || writing_)
+                condition_.wait(lock);
+
+        }
+
+        bool isOpen() {
+
+            boost::mutex::scoped_lock lock(mutex_);
+            return open_;
+
+        }
+
+        // true if the driver accepted the LOW_LATENCY request of the last open();
+        bool lowLatency() const     {return low_latency_;}
+
+        // writes all bytes, blocks until they are passed to the driver;
+        // the write is done by the reactor thread like all other operations on the port object,
+        // so it must not be called by the callbacks of this port;
+        size_t write(const void * data, size_t size, boost::system::error_code & ec) {
+
+            // one write at a time, the reactor thread serves it from write_data_;
+            boost::mutex::scoped_lock write_lock(write_mutex_);
+            boost::mutex::scoped_lock lock(mutex_);
+
+            if (!open_ || closing_) {
+                ec = boost::asio::error::bad_descriptor;
+                return 0;
+            }
+
+            writing_    = true;
+            write_size_ = 0;
+            reactor_.ioService().post(boost::bind(&SerialPort::startWrite, this, data, size));
+
+            while (writing_)
+                condition_.wait(lock);
+
+            ec = write_error_;
+
+            return write_size_;
+
+        }
+
+        // termios configuration of an open file descriptor;
+        static bool configure(int fd, int baud_rate, boost::system::error_code & ec) {
+
+            speed_t speed;
+            if (!baudRateConstant(baud_rate, speed)) {
+                ec = boost::system::error_code(EINVAL, boost::system::system_category());
+                return false;
+            }
+
+            struct termios tio;
+            if (tcgetattr(fd, &tio) != 0) {
+                ec = boost::system::error_code(errno, boost::system::system_category());
+                return false;
+            }
+
+            // raw mode: no line editing, echo, signals or translation of CR/LF and no software flow control;
+            tio.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF | IXANY);
+            tio.c_oflag &= ~OPOST;
+            tio.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+
+            // 8 data bits, no parity, one stop bit, no hardware flow control, modem lines ignored;
+            tio.c_cflag &= ~(CSIZE | PARENB | CSTOPB | CRTSCTS);
+            tio.c_cflag |= CS8 | CREAD | CLOCAL;
+
+            // the reads are non-blocking, but in non-canonical mode with VTIME = 0 the tty reports itself readable
+            // only once VMIN bytes are buffered; VMIN = 1 wakes the reactor for the first byte;
+            tio.c_cc[VMIN]  = 1;
+            tio.c_cc[VTIME] = 0;
+
+            cfsetispeed(&tio, speed);
+            cfsetospeed(&tio, speed);
+
+            if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+                ec = boost::system::error_code(errno, boost::system::system_category());
+                return false;
+            }
+
+            // bytes received before the port was opened are stale;
+            tcflush(fd, TCIFLUSH);
+
+            return true;
+
+        }
+
+        // sets ASYNC_LOW_LATENCY, returns false if the driver does not support it;
+        static bool setLowLatency(int fd) {
+
+            struct serial_struct serial;
+            if (ioctl(fd, TIOCGSERIAL, &serial) != 0)
+                return false;
+
+            serial.flags |= ASYNC_LOW_LATENCY;
+
+            return ioctl(fd, TIOCSSERIAL, &serial) == 0;
+
+        }
+
+        // TIOCEXCL rejects further opens of the tty, flock detects a process which had opened it before;
+        static bool lock(int fd, boost::system::error_code & ec) {
+
+            if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+                ec = boost::system::error_code(errno == EWOULDBLOCK ? EBUSY : errno, boost::system::system_category());
+                return false;
+            }
+
+            if (ioctl(fd, TIOCEXCL) != 0) {
+                ec = boost::system::error_code(errno, boost::system::system_category());
+                return false;
+            }
+
+            return true;
+
+        }
+
+        // termios constant of a baud rate;
+        static bool baudRateConstant(int baud_rate, speed_t & speed) {
+
+            switch (baud_rate) {
+
+                case 1200:      speed = B1200;      return true;
+                case 2400:      speed = B2400;      return true;
+                case 4800:      speed = B4800;      return true;
+                case 9600:      speed = B9600;      return true;
+                case 19200:     speed = B19200;     return true;
+                case 38400:     speed = B38400;     return true;
+                case 57600:     speed = B57600;     return true;
+                case 115200:    speed = B115200;    return true;
+                case 230400:    speed = B230400;    return true;
+#ifdef B460800
+                case 460800:    speed = B460800;    return true;
+#endif
+#ifdef B921600
+                case 921600:    speed = B921600;    return true;
+#endif
+                default:        return false;
+
+            }
+
+        }
+
+    private:
+
+        // reactor thread;
+        void startRead() {
+
+            port_.async_read_some(boost::asio::buffer(read_buffer_, sizeof(read_buffer_)),
+                                  boost::bind(&SerialPort::handleRead, this,
+                                              boost::asio::placeholders::error,
+                                              boost::asio::placeholders::bytes_transferred));
+
+        }
+
+        // reactor thread;
+        void handleRead(const boost::system::error_code & ec, size_t bytes_transferred) {
+
+            if (!ec && bytes_transferred > 0)
+                receive_(read_buffer_, bytes_transferred);
+
+            bool failed = false;
+
+            {
+                boost::mutex::scoped_lock lock(mutex_);
+
+                if (!ec && !closing_) {
+                    startRead();
+                    return;
+                }
+
+                failed = ec && !closing_ && ec != boost::asio::error::operation_aborted;
+                reading_ = false;
+            }
+
+            condition_.notify_all();
+
+            if (failed && error_)
+                error_(ec);
+
+        }
+
+        // reactor thread;
+        void startWrite(const void * data, size_t size) {
+
+            boost::asio::async_write(port_, boost::asio::buffer(data, size),
+                                     boost::bind(&SerialPort::handleWrite, this,
+                                                 boost::asio::placeholders::error,
+                                                 boost::asio::placeholders::bytes_transferred));
+
+        }
+
+        // reactor thread; wakes up the writing thread;
+        void handleWrite(const boost::system::error_code & ec, size_t bytes_transferred) {
+
+            {
+                boost::mutex::scoped_lock lock(mutex_);
+
+                write_error_    = ec;
+                write_size_     = bytes_transferred;
+                writing_        = false;
+            }
+
+            condition_.notify_all();
+
+        }
+
+        // reactor thread; the pending read and write return with operation_aborted;
+        void closePort() {
+
+            boost::system::error_code ignored;
+            port_.cancel(ignored);
+
+            // the exclusive mode belongs to the tty, not to the file descriptor (the flock is released by closing);
+            if (exclusive_)
+                ioctl(port_.native_handle(), TIOCNXCL);
+
+            port_.close(ignored);
+
+            {
+                boost::mutex::scoped_lock lock(mutex_);
+                open_ = false;
+            }
+
+            condition_.notify_all();
+
+        }
+
+        SerialReactor &             reactor_;
+        boost::asio::serial_port    port_;
+        unsigned char               read_buffer_[read_buffer_size];
+
+        ReceiveCallback             receive_;
+        ErrorCallback               error_;
+
+        boost::mutex                mutex_;         // guards the members below
+        boost::condition_variable   condition_;
+        bool                        open_;
+        bool                        reading_;       // a read is pending or its handler is running
+        bool                        closing_;
+        bool                        writing_;       // a write is pending or its handler is running
+        size_t                      write_size_;
+        boost::system::error_code   write_error_;
+
+        boost::mutex                write_mutex_;   // serializes the writing threads
+
+        bool                        low_latency_;
+        bool                        exclusive_;
+
+};
+
+#endif // SERIAL_PORT_H_
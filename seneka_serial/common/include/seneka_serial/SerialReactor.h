@@ -0,0 +1,118 @@
+/*!
+*****************************************************************
+* SerialReactor.h
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_serial
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description: The seneka_serial package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* It holds the serial port handling shared by the sensor drivers: a single event loop thread for all ports, native port configuration and message framing.
+* This package might work with other hardware and can be used for other purposes, however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+
+#ifndef SERIAL_REACTOR_H_
+#define SERIAL_REACTOR_H_
+
+/****************************************/
+/*************** includes ***************/
+/****************************************/
+
+#include <boost/asio/io_service.hpp>
+#include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread.hpp>
+
+/***************************************************/
+/*************** SerialReactor class ***************/
+/***************************************************/
+
+// event loop for the asynchronous reads of all serial ports of a process;
+// a single thread runs the io_service and calls the receive callbacks of all ports (see SerialPort.h);
+// the io_service is kept busy by a work object, so the thread does not return while no read is pending;
+// callbacks run one after another in this thread, they have to be short and must not throw;
+class SerialReactor {
+
+    public:
+
+        SerialReactor() : work_(new boost::asio::io_service::work(io_service_)) {
+
+            thread_ = boost::thread(boost::bind(&SerialReactor::run, this));
+
+        }
+
+        ~SerialReactor() {
+
+            work_.reset();
+            io_service_.stop();
+            thread_.join();
+
+        }
+
+        // reactor shared by all drivers of the process, started on first use;
+        static SerialReactor & shared() {
+
+            static SerialReactor reactor;
+            return reactor;
+
+        }
+
+        boost::asio::io_service & ioService()   {return io_service_;}
+
+    private:
+
+        void run() {
+
+            io_service_.run();
+
+        }
+
+        boost::asio::io_service                             io_service_;
+        boost::scoped_ptr<boost::asio::io_service::work>    work_;
+        boost::thread                                       thread_;
+
+};
+
+#endif // SERIAL_REACTOR_H_
@@ -0,0 +1,246 @@
+/*!
+*****************************************************************
+* serialLatencyProbe.cpp
+*
+* Copyright (c) 2014
+* Fraunhofer Institute for Manufacturing Engineering
+* and Automation (IPA)
+*
+*****************************************************************
+*
+* Repository name: seneka_sensor_node
+*
+* ROS package name: seneka_serial
+*
+* Supervised by: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+*
+* Date of creation: Oct 2026
+* Modified xx/20xx:
+*
+* Description: The seneka_serial package is part of the seneka_sensor_node metapackage, developed for the SeNeKa project at Fraunhofer IPA.
+* It holds the serial port handling shared by the sensor drivers: a single event loop thread for all ports, native port configuration and message framing.
+* This package might work with other hardware and can be used for other purposes, however the development has been specifically for this project and the deployed sensors.
+*
+*****************************************************************
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* - Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer. \n
+* - Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution. \n
+* - Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission. \n
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+
+// Measures the round trip delay from writing a byte to the receive callback of SerialPort.
+// Without a device, a pty pair is opened and an echo thread returns every byte, which shows
+// the overhead of the tty layer and the reactor thread. A real port needs a loopback plug
+// (TX connected to RX) and is measured with and without the LOW_LATENCY flag, which shows
+// the delay added by the adapter (e.g. the latency timer of USB serial adapters).
+//
+// usage: serial_latency_probe [device [baud_rate [count]]]
+
+#include <seneka_serial/SerialPort.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pty.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+// timeout for a single probe byte in ms;
+#define PROBE_TIMEOUT ( 1000 )
+
+// pause between two probe bytes in ms, so every byte finds an idle adapter;
+#define PROBE_PAUSE ( 2 )
+
+/******************************************************/
+/*************** round trip measurement ***************/
+/******************************************************/
+
+struct Probe {
+
+    boost::mutex                mutex;
+    boost::condition_variable   condition;
+    unsigned char               expected;
+    bool                        received;
+    boost::posix_time::ptime    receive_time;
+
+    // reactor thread;
+    void receive(const unsigned char * data, size_t size) {
+
+        boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            for (size_t i = 0; i < size; i++) {
+                if (data[i] == expected && !received) {
+                    received = true;
+                    receive_time = now;
+                }
+            }
+        }
+
+        condition.notify_all();
+
+    }
+
+};
+
+// echo thread of the pty mode, returns as soon as the slave side is closed;
+void echo(int master) {
+
+    unsigned char buffer[256];
+    ssize_t size;
+
+    while ((size = read(master, buffer, sizeof(buffer))) > 0) {
+        if (write(master, buffer, size) != size)
+            return;
+    }
+
+}
+
+// returns false if the port could not be opened;
+bool measure(const std::string & device, int baud_rate, int count, int flags, const char * mode) {
+
+    Probe probe;
+    probe.expected = 0;
+    probe.received = true;
+
+    SerialPort port;
+    boost::system::error_code ec;
+
+    if (!port.open(device, baud_rate, boost::bind(&Probe::receive, &probe, _1, _2), SerialPort::ErrorCallback(), ec, flags)) {
+        printf("could not open %s: %s\n", device.c_str(), ec.message().c_str());
+        return false;
+    }
+
+    std::vector<long> delays;
+    int lost = 0;
+
+    for (int i = 0; i < count; i++) {
+
+        unsigned char byte = (unsigned char) (i & 0xff);
+
+        {
+            boost::mutex::scoped_lock lock(probe.mutex);
+            probe.expected = byte;
+            probe.received = false;
+        }
+
+        boost::posix_time::ptime send_time = boost::posix_time::microsec_clock::universal_time();
+        port.write(&byte, 1, ec);
+
+        {
+            boost::system_time deadline = boost::get_system_time() + boost::posix_time::milliseconds(PROBE_TIMEOUT);
+            boost::mutex::scoped_lock lock(probe.mutex);
+
+            while (!probe.received && probe.condition.timed_wait(lock, deadline));
+
+            if (probe.received)
+                delays.push_back((probe.receive_time - send_time).total_microseconds());
+            else
+                lost++;
+        }
+
+        boost::this_thread::sleep(boost::posix_time::milliseconds(PROBE_PAUSE));
+
+    }
+
+    port.close();
+
+    printf("%-12s %-11s", mode, port.lowLatency() ? "yes" : "no");
+
+    if (delays.empty()) {
+        printf("   no byte returned, %d lost\n", lost);
+        return true;
+    }
+
+    std::sort(delays.begin(), delays.end());
+    size_t n = delays.size();
+
+    printf(" %8ld %8ld %8ld %8ld %8ld %6d\n",
+           delays[0], delays[n / 2], delays[n * 9 / 10], delays[n * 99 / 100], delays[n - 1], lost);
+
+    return true;
+
+}
+
+int main(int argc, char** argv) {
+
+    std::string device  = argc > 1 ? argv[1] : "";
+    int baud_rate       = argc > 2 ? atoi(argv[2]) : 115200;
+    int count           = argc > 3 ? atoi(argv[3]) : 1000;
+
+    speed_t speed;
+    if (!SerialPort::baudRateConstant(baud_rate, speed) || count <= 0) {
+        printf("usage: %s [device [baud_rate [count]]]\n", argv[0]);
+        return 1;
+    }
+
+    int master = -1;
+    int slave = -1;
+    boost::thread echo_thread;
+
+    if (device.empty()) {
+
+        // the slave stays open, otherwise reading the master fails until the port is opened;
+        char name[256];
+        if (openpty(&master, &slave, name, NULL, NULL) != 0) {
+            perror("openpty");
+            return 1;
+        }
+
+        device = name;
+        echo_thread = boost::thread(boost::bind(&echo, master));
+
+    }
+
+    printf("%s, %d baud, %d bytes, byte time %.1f us\n", device.c_str(), baud_rate, count, 10e6 / baud_rate);
+    printf("round trip delay [us]\n");
+    printf("%-12s %-11s %8s %8s %8s %8s %8s %6s\n", "mode", "low latency", "min", "median", "p90", "p99", "max", "lost");
+
+    bool ok;
+
+    if (master >= 0) {
+        ok = measure(device, baud_rate, count, SerialPort::LOW_LATENCY | SerialPort::EXCLUSIVE, "pty");
+    }
+    else {
+        ok = measure(device, baud_rate, count, SerialPort::EXCLUSIVE, "default")
+          && measure(device, baud_rate, count, SerialPort::LOW_LATENCY | SerialPort::EXCLUSIVE, "low latency");
+    }
+
+    if (master >= 0) {
+        ::close(slave);
+        echo_thread.join();
+        ::close(master);
+    }
+
+    return ok ? 0 : 1;
+
+}
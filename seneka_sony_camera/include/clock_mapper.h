@@ -0,0 +1,112 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef CLOCK_MAPPER_H
+#define CLOCK_MAPPER_H
+
+// standard headers
+#include <deque>
+#include <stdint.h>
+
+// ros headers
+#include <ros/ros.h>
+
+// Maps the timestamps of the camera clock to ROS time.
+// Every frame gives a pair of its device timestamp and the host time it was
+// received at. The difference of both is the clock offset plus a transfer
+// delay which is never negative, so the offset is estimated by the lower
+// envelope of the differences. The drift of the camera clock is the slope
+// between the minimal differences of the older and the newer half of the
+// window, which is not affected by the delay jitter of the single frames.
+class Clock_Mapper
+{
+    private:
+
+        void estimate();
+
+        double tick_frequency_;
+        size_t window_;
+
+        bool initialized_;
+        uint64_t reference_ticks_;
+        uint64_t last_ticks_;
+        ros::Time reference_time_;
+
+        // device time and host time minus device time in s, relative to the references
+        std::deque<std::pair<double, double> > samples_;
+
+        double drift_;
+        double offset_;
+
+    public:
+
+        // Constructor/Destructor
+        Clock_Mapper(double tick_frequency, size_t window);
+        ~Clock_Mapper();
+
+        // public member function prototypes
+        void reset();
+        ros::Time update(uint64_t device_ticks, const ros::Time& host_time);
+        ros::Time toHostTime(uint64_t device_ticks) const;
+        double getDrift() {return drift_;};
+        size_t getSamples() {return samples_.size();};
+};
+
+#endif // CLOCK_MAPPER_H
@@ -0,0 +1,132 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef CONTROL_QUEUE_H
+#define CONTROL_QUEUE_H
+
+// standard headers
+#include <list>
+#include <string>
+
+// boost headers
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+
+// ros headers
+#include <ros/ros.h>
+
+// Queue of camera control commands, executed one after the other by a
+// worker thread, so neither the service callbacks nor the image
+// acquisition wait for the GenICam round-trips. Only the latest command of
+// a name matters: a queued command is replaced by a newer one of the same
+// name, which moves to the end of the queue. The outcome of every command
+// is reported to the result callback, which is called by the worker thread
+// (and by push for replaced commands).
+class Control_Queue
+{
+    public:
+
+        enum Status {EXECUTED = 0, FAILED = 1, SUPERSEDED = 2};
+
+        struct Result
+        {
+            std::string name;
+            Status status;
+            double queue_time;      // s between push and execution
+            double execution_time;  // s
+        };
+
+        typedef boost::function<bool ()> Command;     // returns false if the command failed
+        typedef boost::function<void ()> Action;      // command without a result
+        typedef boost::function<void (const Result&)> Result_Callback;
+
+    private:
+
+        struct Entry
+        {
+            std::string name;
+            Command command;
+            ros::WallTime queued;
+        };
+
+        void work();
+
+        Result_Callback callback_;
+        std::list<Entry> entries_;
+        bool running_;
+        boost::thread worker_thread_;
+        boost::mutex mutex_;
+        boost::condition_variable condition_;
+
+    public:
+
+        // Constructor/Destructor
+        Control_Queue(const Result_Callback& callback);
+        ~Control_Queue();
+
+        // public member function prototypes
+        void start();
+        void stop();
+        void push(const std::string& name, const Command& command);
+        void pushAction(const std::string& name, const Action& action);
+        size_t size();
+};
+
+#endif // CONTROL_QUEUE_H
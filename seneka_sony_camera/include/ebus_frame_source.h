@@ -0,0 +1,107 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef EBUS_FRAME_SOURCE_H
+#define EBUS_FRAME_SOURCE_H
+
+// standard headers
+#include <string>
+
+// pleora ebus sdk headers
+#include <PvSampleUtils.h>
+#include <PvDevice.h>
+#include <PvBuffer.h>
+#include <PvStream.h>
+#include <PvStreamRaw.h>
+
+// seneka_sony_camera headers
+#include "frame_source.h"
+
+// Frames of the camera, streamed with the eBus SDK. The device has to be
+// connected already, it stays under the control of the camera node.
+class Ebus_Frame_Source : public Frame_Source
+{
+    private:
+
+        PvDevice* device_;
+        PvGenParameterArray* device_params_;
+        std::string address_;
+
+        PvStream stream_;
+        PvBuffer* buffers_;
+        PvUInt32 buffer_count_;
+        PvBuffer* retrieved_buffer_;    // handed out by retrieve, queued again by release
+        double tick_frequency_;
+
+    public:
+
+        // Constructor/Destructor
+        Ebus_Frame_Source(PvDevice* device, const std::string& address);
+        ~Ebus_Frame_Source();
+
+        // public member function prototypes
+        bool start();
+        void stop();
+        bool retrieve(Frame& frame, unsigned int timeout);
+        void release();
+        double getTickFrequency() {return tick_frequency_;};
+};
+
+#endif // EBUS_FRAME_SOURCE_H
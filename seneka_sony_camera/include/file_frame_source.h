@@ -0,0 +1,120 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef FILE_FRAME_SOURCE_H
+#define FILE_FRAME_SOURCE_H
+
+// standard headers
+#include <fstream>
+#include <string>
+#include <vector>
+
+// seneka_sony_camera headers
+#include "frame_source.h"
+
+// Replays captured frames from a file. Two formats are supported:
+// - pcap captures of the GigE Vision stream (GVSP over UDP), as written by
+//   tcpdump in seneka_scenarios/video_capture/capture.sh, the frames are
+//   reassembled from the leader, payload and trailer packets
+// - raw files with consecutive UYVY frames of a given size
+// The leader timestamps of the capture have an unknown tick frequency, so
+// the replayed frames are stamped with their arrival time.
+class File_Frame_Source : public Frame_Source
+{
+    private:
+
+        bool readRawFrame();
+        bool readPcapFrame();
+        bool readPcapPacket(std::vector<unsigned char>& packet);
+        bool rewind();
+
+        std::string file_name_;
+        int width_;
+        int height_;
+        double rate_;
+        bool loop_;
+
+        std::ifstream file_;
+        bool pcap_;
+        bool swapped_;          // byte order of the pcap headers differs from the host
+        unsigned int link_type_;
+        std::streampos first_record_;
+
+        std::vector<unsigned char> frame_;
+        std::vector<unsigned char> packet_;
+        int frame_width_;
+        int frame_height_;
+        unsigned long incomplete_frames_;
+
+    public:
+
+        // Constructor/Destructor
+        File_Frame_Source(const std::string& file_name, int width, int height, double rate, bool loop);
+        ~File_Frame_Source();
+
+        // public member function prototypes
+        bool start();
+        void stop();
+        bool retrieve(Frame& frame, unsigned int timeout);
+        void release();
+        double getTickFrequency() {return 0.0;};
+};
+
+#endif // FILE_FRAME_SOURCE_H
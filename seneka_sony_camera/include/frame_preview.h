@@ -0,0 +1,110 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef FRAME_PREVIEW_H
+#define FRAME_PREVIEW_H
+
+// standard headers
+#include <string>
+
+// boost headers
+#include <boost/thread.hpp>
+
+// opencv headers
+#include <opencv2/opencv.hpp>
+
+// Debug screen with its own display thread.
+// show() copies the frame into a mailbox with a single slot and returns
+// immediately, the display thread shows the latest frame. Frames replaced
+// before they are displayed and frames above the maximal rate are dropped,
+// so the GUI never slows down the image publisher.
+class Frame_Preview
+{
+    private:
+
+        // function prototypes
+        void display();
+
+        std::string window_name_;
+        boost::posix_time::time_duration min_interval_;
+        boost::posix_time::ptime last_accepted_;
+
+        // mailbox with a single slot
+        cv::Mat mailbox_;
+        bool frame_available_;
+        boost::mutex mailbox_mutex_;
+        boost::condition_variable mailbox_condition_;
+
+        boost::thread display_thread_;
+        bool running_;
+
+    public:
+
+        // Constructor/Destructor
+        Frame_Preview(const std::string& window_name, double max_rate);
+        ~Frame_Preview();
+
+        // public member function prototypes
+        void start();
+        void stop();
+        void show(const cv::Mat& frame);
+};
+
+#endif // FRAME_PREVIEW_H
@@ -0,0 +1,113 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef FRAME_SOURCE_H
+#define FRAME_SOURCE_H
+
+// standard headers
+#include <cstddef>
+#include <stdint.h>
+
+// boost headers
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+// Source of raw UYVY (YUV 4:2:2) frames for the image pipeline.
+// The camera is one implementation, the others replay captured frames or
+// generate synthetic ones, so the pipeline also runs without the camera and
+// the eBus SDK.
+class Frame_Source
+{
+    protected:
+
+        // waits until the next frame is due, false if this takes longer than timeout ms
+        bool waitForFrame(double rate, unsigned int timeout);
+
+        boost::posix_time::ptime next_frame_;
+
+    public:
+
+        // frame handed out by retrieve, the data is valid until release is called
+        struct Frame
+        {
+            const unsigned char* data;
+            size_t size;            // valid bytes at data
+            int width;
+            int height;
+            int step;               // bytes per row including padding, at least width * 2
+            uint64_t timestamp;     // device timestamp in ticks of getTickFrequency()
+        };
+
+        // Constructor/Destructor
+        Frame_Source();
+        virtual ~Frame_Source();
+
+        // public member function prototypes
+        virtual bool start() = 0;
+        virtual void stop() = 0;
+
+        // waits up to timeout ms for the next frame
+        virtual bool retrieve(Frame& frame, unsigned int timeout) = 0;
+        virtual void release() = 0;
+
+        // frequency of the device timestamps in Hz, 0 if the frames have no device timestamps
+        virtual double getTickFrequency() = 0;
+};
+
+#endif // FRAME_SOURCE_H
@@ -0,0 +1,186 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef IMAGE_PIPELINE_H
+#define IMAGE_PIPELINE_H
+
+// standard headers
+#include <string>
+#include <vector>
+
+// boost headers
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+
+// ros headers
+#include <ros/ros.h>
+#include <sensor_msgs/image_encodings.h>
+#include <sensor_msgs/Image.h>
+#include <sensor_msgs/CompressedImage.h>
+#include <image_transport/image_transport.h>
+
+// seneka message headers
+#include <seneka_msg/LatencyHistogram.h>
+
+// seneka_image_processing headers
+#include <seneka_image_processing/RowBandPool.h>
+
+// seneka_sony_camera headers
+#include "frame_source.h"
+#include "frame_preview.h"
+#include "yuv_converter.h"
+#include "image_pool.h"
+#include "clock_mapper.h"
+#include "latency_histogram.h"
+#include "jpeg_encoder.h"
+
+// Publishing path of the camera images, independent of the eBus SDK.
+// An acquisition thread copies the frames of a Frame_Source into pooled
+// messages and a processing thread publishes them: the native UYVY image on
+// SonyGigCam_yuv_image and, only if they are used, the RGB image on
+// SonyGigCam_rgb_image, a downscaled preview on SonyGigCam_preview_image and
+// region of interest crops on SonyGigCam_roi_image_<n>. All RGB images of a
+// frame are converted in the same pass over the raw image. JPEG images are
+// compressed by a worker pool and published on SonyGigCam_jpeg/compressed.
+class Image_Pipeline
+{
+    private:
+
+        // region of interest in pixels of the full resolution image
+        struct Region
+        {
+            int x, y, width, height;
+        };
+
+        // images converted from one raw image, NULL if not used
+        struct Conversion
+        {
+            sensor_msgs::Image* rgb;
+            sensor_msgs::Image* preview;
+            std::vector<sensor_msgs::Image*> rois;
+            std::vector<Region> regions;    // clipped to the raw image
+        };
+
+        // function prototypes
+        void acquireImages();
+        void processImages();
+        void publishImage(const sensor_msgs::ImageConstPtr& raw);
+        void convertRows(const sensor_msgs::Image* raw, const Conversion* conversion, int begin, int end);
+        void publishJpeg(const sensor_msgs::CompressedImagePtr& compressed, bool record_latency);
+        void recordLatency(const ros::Time& stamp);
+        bool parseRegions(const std::string& str);
+
+        bool debug_screen_param;
+        double debug_screen_rate_param;
+        int conversion_threads_param;
+        double timestamp_offset_param;
+        int clock_window_param;
+        double latency_period_param;
+        int preview_scale_param;
+        std::string regions_of_interest_param;
+        int jpeg_threads_param;
+        int jpeg_quality_param;
+        std::vector<Region> regions_;
+
+        Frame_Source* source_;
+        Frame_Preview* preview_;
+        Image_Pool* image_pool_;
+        Image_Pool* raw_image_pool_;
+        Image_Pool* preview_pool_;
+        std::vector<Image_Pool*> roi_pools_;
+        RowBandPool* conversion_pool_;
+        Jpeg_Encoder* jpeg_encoder_;
+        Clock_Mapper* clock_mapper_;    // NULL if the frames have no device timestamps
+        double clock_drift_;            // of clock_mapper_, guarded by latency_mutex_
+        Latency_Histogram* latency_histogram_;
+        ros::Time latency_published_;
+        boost::mutex latency_mutex_;            // recordLatency is also called by the encoder threads,
+                                                // clock_mapper_ is replaced under this mutex
+
+        // acquisition and processing threads
+        boost::thread acquisition_thread_;
+        boost::thread processing_thread_;
+        boost::atomic<bool> acquiring_;         // read by both threads without frame_mutex_
+        sensor_msgs::ImagePtr pending_frame_;   // latest raw image, not processed yet
+        unsigned long dropped_frames_;
+        boost::mutex frame_mutex_;
+        boost::condition_variable frame_condition_;
+
+        image_transport::ImageTransport it;
+        image_transport::Publisher publish_rgb_image;
+        image_transport::Publisher publish_raw_image;
+        image_transport::Publisher publish_preview_image;
+        std::vector<image_transport::Publisher> publish_roi_images;
+        ros::Publisher publish_jpeg_image;
+        ros::Publisher publish_latency;
+
+    public:
+
+        // Constructor/Destructor
+        Image_Pipeline(ros::NodeHandle& nh, ros::NodeHandle& pnh);
+        ~Image_Pipeline();
+
+        // public member function prototypes
+        bool start(Frame_Source* source);
+        void stop();
+        bool isRunning() {return acquiring_;};
+};
+
+#endif // IMAGE_PIPELINE_H
@@ -0,0 +1,139 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef JPEG_ENCODER_H
+#define JPEG_ENCODER_H
+
+// standard headers
+#include <deque>
+#include <map>
+#include <vector>
+
+// boost headers
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+
+// ros headers
+#include <sensor_msgs/Image.h>
+#include <sensor_msgs/CompressedImage.h>
+
+// JPEG compression of the raw camera images on a pool of worker threads.
+// Every worker converts a whole frame and encodes it, so several frames are
+// compressed at the same time. The compressed images are handed to the
+// publish callback in the order of the frames together with the
+// record_latency flag of their frame, and a frame is skipped if the workers
+// and the queue are busy, so the encoder never delays the acquisition.
+class Jpeg_Encoder
+{
+    public:
+
+        typedef boost::function<void (const sensor_msgs::CompressedImagePtr&, bool record_latency)> Publish_Callback;
+
+    private:
+
+        struct Job
+        {
+            unsigned long sequence;
+            sensor_msgs::ImageConstPtr raw;
+            bool record_latency;
+        };
+
+        struct Encoded
+        {
+            sensor_msgs::CompressedImagePtr compressed;
+            bool record_latency;
+        };
+
+        void work();
+        void emit();
+
+        Publish_Callback callback_;
+        int quality_;
+        unsigned int max_frames_;       // frames queued or being encoded
+
+        boost::thread_group workers_;
+        boost::mutex mutex_;
+        boost::condition_variable condition_;
+        boost::condition_variable emitted_;
+        bool running_;
+
+        // guarded by mutex_
+        std::deque<Job> jobs_;
+        std::map<unsigned long, Encoded> encoded_;
+        unsigned long next_sequence_;   // of the next submitted frame
+        unsigned long next_emit_;       // of the next published frame
+        unsigned int frames_;
+        bool emitting_;
+        unsigned long skipped_frames_;
+
+    public:
+
+        // Constructor/Destructor
+        Jpeg_Encoder(unsigned int threads, int quality, const Publish_Callback& callback);
+        ~Jpeg_Encoder();
+
+        // public member function prototypes
+        bool encode(const sensor_msgs::ImageConstPtr& raw, bool record_latency);
+        void flush();
+        unsigned int getMaxFrames() {return max_frames_;};
+        unsigned long getSkippedFrames();
+};
+
+#endif // JPEG_ENCODER_H
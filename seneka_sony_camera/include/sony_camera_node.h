@@ -63,6 +63,12 @@
 
 // standart headers
 #include "stdio.h"
+#include <cstring>
+#include <vector>
+
+// boost headers
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
 
 // ros headers
 #include <ros/ros.h>
@@ -88,6 +94,9 @@
 #include <seneka_srv/titleText.h>
 #include <seneka_srv/streaming.h>
 
+// seneka message headers
+#include <seneka_msg/ControlStatus.h>
+
 // pleora ebus sdk headers
 #include <PvSampleUtils.h>
 #include <PvDevice.h>
@@ -104,6 +113,11 @@
 #include "opencv/highgui.h"
 #include <opencv2/opencv.hpp>
 
+// seneka_sony_camera headers
+#include "image_pipeline.h"
+#include "ebus_frame_source.h"
+#include "control_queue.h"
+
 #ifndef SONY_CAMERA_NODE_H
 #define SONY_CAMERA_NODE_H
 
@@ -133,6 +147,8 @@ class Sony_Camera_Node
         void infraredCutFilter(int val);
         void infraredCutFilterAuto(int val);
         void streaming(bool decider);
+        bool setFocusPosition(int val);
+        void controlResult(const Control_Queue::Result& result);
 
         std::string camera_ip_address_param;
         std::string titleText_param;
@@ -150,19 +166,16 @@ class Sony_Camera_Node
         int infraredCutFilter_param;
         int infraredCutFilterAuto_param;
         bool streaming_param;
-        bool debug_screen_param;
+        Image_Pipeline* pipeline_;
+        Ebus_Frame_Source* frame_source_;
+        Control_Queue* control_queue_;
 
-        PvInt64 lSize;
         PvInt64 focus_pos;
         PvInt64 focus_auto;
         bool flag;
-        PvBuffer *lBuffers;
         PvDevice lDevice;
         PvResult lResult;
-        PvStream lStream;
         PvGenParameterArray *lDeviceParams;
-        PvGenInteger *lPayloadSize;
-        PvInt64 width_, height_ ;
 
         public:
     
@@ -187,13 +200,10 @@ class Sony_Camera_Node
                             titleText_service,
                             streaming_service;
 
-        image_transport::ImageTransport it;
-        image_transport::Publisher publish_rgb_image;
+        ros::Publisher publish_control_status;
         cv_bridge::CvImage out_msg;
 
         // public member function prototypes
-        void publishImage();
-
         bool getStreamingParam(void) {return streaming_param;};
 
         // ros service callback function prototypes
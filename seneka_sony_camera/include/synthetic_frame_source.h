@@ -0,0 +1,98 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef SYNTHETIC_FRAME_SOURCE_H
+#define SYNTHETIC_FRAME_SOURCE_H
+
+// standard headers
+#include <vector>
+
+// seneka_sony_camera headers
+#include "frame_source.h"
+
+// Generates moving colour bars at a fixed rate and size. The frames are
+// prepared in start, so retrieving them costs no time and the measured
+// load is the one of the image pipeline alone.
+class Synthetic_Frame_Source : public Frame_Source
+{
+    private:
+
+        int width_;
+        int height_;
+        double rate_;
+        std::vector<std::vector<unsigned char> > frames_;
+        size_t next_;
+        boost::posix_time::ptime start_time_;
+
+    public:
+
+        // Constructor/Destructor
+        Synthetic_Frame_Source(int width, int height, double rate);
+        ~Synthetic_Frame_Source();
+
+        // public member function prototypes
+        bool start();
+        void stop();
+        bool retrieve(Frame& frame, unsigned int timeout);
+        void release();
+        double getTickFrequency() {return 1000000.0;};
+};
+
+#endif // SYNTHETIC_FRAME_SOURCE_H
@@ -0,0 +1,93 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef YUV_CONVERTER_H
+#define YUV_CONVERTER_H
+
+// Conversion of the YUV 4:2:2 (UYVY) camera images to the published 8 bit
+// 3 channel images. The conversion uses fixed point arithmetic with 14 bit
+// coefficients and a SIMD implementation (SSE2 or NEON, selected at compile
+// time; on x86 an AVX2 kernel is used instead if the CPU supports it) with a
+// scalar fallback, which gives identical results.
+// Compared to the double precision formula of the original publishImage()
+// loop (yuvToRgbReference) every channel differs by at most 1.
+
+// convert height rows of width pixels (width has to be even)
+void yuvToRgb(const unsigned char* src, int src_step,
+              unsigned char* dst, int dst_step,
+              int width, int height);
+
+// convert a downscaled image of height rows of width / scale pixels: every
+// output pixel is the mean of the pixel pair in the middle of the first row of
+// its scale x scale block, so only every scale-th source row is read;
+// src points to the first source row of the first output row
+void yuvToRgbDownscaled(const unsigned char* src, int src_step,
+                        unsigned char* dst, int dst_step,
+                        int width, int height, int scale);
+
+// original double precision per pixel conversion, used as reference
+void yuvToRgbReference(const unsigned char* src, int src_step,
+                       unsigned char* dst, int dst_step,
+                       int width, int height);
+
+// name of the used implementation ("avx2", "sse2", "neon" or "scalar")
+const char* yuvToRgbImplementation();
+
+#endif // YUV_CONVERTER_H
@@ -0,0 +1,95 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#ifndef YUV_CONVERTER_KERNELS_H
+#define YUV_CONVERTER_KERNELS_H
+
+// Internals of yuv_converter.cpp shared with the kernels which are compiled
+// with other instruction set flags.
+
+// fixed point coefficients (14 bit fraction) of the original formula
+//   out[0] = y + 1.772 * (u-128)
+//   out[1] = y - 0.34413 * (u-128) - 0.71414 * (v-128)
+//   out[2] = y + 8 + 1.402 * (v-128)
+#define YUV_C0_U   29032
+#define YUV_C1_U  (-5638)
+#define YUV_C1_V  (-11700)
+#define YUV_C2_V   22970
+#define YUV_C2_OFFSET 8
+
+// both green coefficients in one 32 bit value for madd (u in the lower half)
+#define YUV_C1_PAIR (int)(((unsigned int)YUV_C1_V << 16) | ((unsigned int)YUV_C1_U & 0xFFFF))
+
+#define clip(x) (unsigned char)( (x) < 0 ? 0 : ( (x) > 255 ? 255 : (x) ) )
+
+// The AVX2 kernel is built on x86 and selected at runtime by yuvToRgb() if the
+// CPU supports it (the CMake file compiles yuv_converter_avx2.cpp with -mavx2).
+#if defined(__x86_64__) || defined(__i386__)
+#define YUV_CONVERTER_AVX2
+
+// converts the first pixels of a row in blocks of 64 pixels, returns the
+// number of converted pixels; the caller converts the rest
+int yuvToRgbAvx2(const unsigned char* src, unsigned char* dst, int width);
+
+// false if yuv_converter_avx2.cpp was compiled without -mavx2
+bool yuvToRgbAvx2Compiled();
+#endif
+
+#endif // YUV_CONVERTER_KERNELS_H
@@ -0,0 +1,161 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#include "clock_mapper.h"
+
+// samples needed before the drift is estimated
+#define MIN_DRIFT_SAMPLES ( 20 )
+
+// minimal time between the two halves of the window for a drift estimate in s
+#define MIN_DRIFT_SPAN ( 1.0 )
+
+// constructor
+Clock_Mapper::Clock_Mapper(double tick_frequency, size_t window)
+{
+    tick_frequency_ = tick_frequency;
+    window_ = window > 2 ? window : 2;
+    reset();
+}
+
+// destructor
+Clock_Mapper::~Clock_Mapper()
+{
+}
+
+// forgets all samples, e.g. after the device clock was reset
+void Clock_Mapper::reset()
+{
+    initialized_ = false;
+    reference_ticks_ = 0;
+    last_ticks_ = 0;
+    samples_.clear();
+    drift_ = 0.0;
+    offset_ = 0.0;
+}
+
+// adds a frame which was stamped with device_ticks by the camera and
+// received at host_time, returns the host time of the device timestamp
+ros::Time Clock_Mapper::update(uint64_t device_ticks, const ros::Time& host_time)
+{
+    // the device clock was reset or wrapped around
+    if (initialized_ && device_ticks < last_ticks_)
+        reset();
+
+    if (!initialized_)
+    {
+        reference_ticks_ = device_ticks;
+        reference_time_ = host_time;
+        initialized_ = true;
+    }
+    last_ticks_ = device_ticks;
+
+    double device = (device_ticks - reference_ticks_) / tick_frequency_;
+    double host = (host_time - reference_time_).toSec();
+
+    samples_.push_back(std::make_pair(device, host - device));
+    if (samples_.size() > window_)
+        samples_.pop_front();
+
+    estimate();
+
+    return toHostTime(device_ticks);
+}
+
+// host time of a device timestamp, only valid after the first update
+ros::Time Clock_Mapper::toHostTime(uint64_t device_ticks) const
+{
+    double device = ((double) device_ticks - (double) reference_ticks_) / tick_frequency_;
+    return reference_time_ + ros::Duration(device * (1.0 + drift_) + offset_);
+}
+
+void Clock_Mapper::estimate()
+{
+    size_t n = samples_.size();
+
+    // minimal difference of the older and the newer half of the window
+    if (n >= MIN_DRIFT_SAMPLES)
+    {
+        size_t old_min = 0;
+        size_t new_min = n / 2;
+        for (size_t i = 1; i < n / 2; i++)
+        {
+            if (samples_[i].second < samples_[old_min].second)
+                old_min = i;
+        }
+        for (size_t i = n / 2 + 1; i < n; i++)
+        {
+            if (samples_[i].second < samples_[new_min].second)
+                new_min = i;
+        }
+
+        double span = samples_[new_min].first - samples_[old_min].first;
+        if (span >= MIN_DRIFT_SPAN)
+            drift_ = (samples_[new_min].second - samples_[old_min].second) / span;
+    }
+
+    // lower envelope of the differences after removing the drift
+    offset_ = samples_[0].second - drift_ * samples_[0].first;
+    for (size_t i = 1; i < n; i++)
+    {
+        double offset = samples_[i].second - drift_ * samples_[i].first;
+        if (offset < offset_)
+            offset_ = offset;
+    }
+}
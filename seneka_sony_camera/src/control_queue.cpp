@@ -0,0 +1,193 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#include "control_queue.h"
+
+#include <boost/bind.hpp>
+
+// commands without a result always succeed
+static bool runAction(const Control_Queue::Action& action)
+{
+    action();
+    return true;
+}
+
+// constructor
+Control_Queue::Control_Queue(const Result_Callback& callback)
+{
+    callback_ = callback;
+    running_ = false;
+}
+
+// destructor
+Control_Queue::~Control_Queue()
+{
+    stop();
+}
+
+// start the worker thread
+void Control_Queue::start()
+{
+    if (!running_)
+    {
+        running_ = true;
+        worker_thread_ = boost::thread(boost::bind(&Control_Queue::work, this));
+    }
+}
+
+// stop the worker thread after the running command, queued commands are dropped
+void Control_Queue::stop()
+{
+    if (running_)
+    {
+        {
+            boost::mutex::scoped_lock lock(mutex_);
+            running_ = false;
+        }
+        condition_.notify_one();
+        worker_thread_.join();
+
+        // service callbacks may still push commands
+        size_t dropped;
+        {
+            boost::mutex::scoped_lock lock(mutex_);
+            dropped = entries_.size();
+            entries_.clear();
+        }
+        if (dropped > 0)
+            ROS_WARN("Dropped %d queued camera control commands.", (int) dropped);
+    }
+}
+
+// queue a command, a queued command of the same name is replaced
+void Control_Queue::push(const std::string& name, const Command& command)
+{
+    Entry entry;
+    entry.name = name;
+    entry.command = command;
+    entry.queued = ros::WallTime::now();
+
+    bool superseded = false;
+    Result result;
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+        for (std::list<Entry>::iterator it = entries_.begin(); it != entries_.end(); ++it)
+        {
+            if (it->name == name)
+            {
+                result.queue_time = (entry.queued - it->queued).toSec();
+                entries_.erase(it);
+                superseded = true;
+                break;
+            }
+        }
+        entries_.push_back(entry);
+    }
+    condition_.notify_one();
+
+    if (superseded)
+    {
+        result.name = name;
+        result.status = SUPERSEDED;
+        result.execution_time = 0.0;
+        callback_(result);
+    }
+}
+
+void Control_Queue::pushAction(const std::string& name, const Action& action)
+{
+    push(name, Command(boost::bind(&runAction, action)));
+}
+
+size_t Control_Queue::size()
+{
+    boost::mutex::scoped_lock lock(mutex_);
+    return entries_.size();
+}
+
+// worker thread: executes the commands in the order of the queue
+void Control_Queue::work()
+{
+    while (true)
+    {
+        Entry entry;
+        {
+            boost::mutex::scoped_lock lock(mutex_);
+            while (running_ && entries_.empty())
+                condition_.wait(lock);
+
+            if (!running_)
+                break;
+
+            entry = entries_.front();
+            entries_.pop_front();
+        }
+
+        Result result;
+        result.name = entry.name;
+        ros::WallTime start = ros::WallTime::now();
+        result.status = entry.command() ? EXECUTED : FAILED;
+        ros::WallTime end = ros::WallTime::now();
+        result.queue_time = (start - entry.queued).toSec();
+        result.execution_time = (end - start).toSec();
+
+        callback_(result);
+    }
+}
@@ -0,0 +1,222 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#include "ebus_frame_source.h"
+
+#include <ros/ros.h>
+
+// several buffers, so the camera can deliver the next image while one is retrieved
+#define BUFFER_COUNT ( 4 )
+
+// constructor
+Ebus_Frame_Source::Ebus_Frame_Source(PvDevice* device, const std::string& address)
+{
+    device_ = device;
+    device_params_ = device_->GetGenParameters();
+    address_ = address;
+    buffers_ = NULL;
+    buffer_count_ = 0;
+    retrieved_buffer_ = NULL;
+    tick_frequency_ = 0.0;
+}
+
+// destructor
+Ebus_Frame_Source::~Ebus_Frame_Source()
+{
+    stop();
+}
+
+bool Ebus_Frame_Source::start()
+{
+    //Camera's ip address
+    PvString address = address_.c_str();
+
+    //Negotiate streaming packet size
+    device_->NegotiatePacketSize();
+
+    //Open stream - have the PvDevice do it for us
+    ROS_INFO("3. Opening stream to device.");
+    stream_.Open( address );
+
+    //Reading payload size from device
+    PvInt64 lSize = 0;
+    PvGenInteger *lPayloadSize = dynamic_cast<PvGenInteger *>( device_params_->Get( "PayloadSize" ) );
+    lPayloadSize->GetValue( lSize );
+
+    // Use min of BUFFER_COUNT and how many buffers can be queued in PvStream
+    buffer_count_ = ( stream_.GetQueuedBufferMaximum() < BUFFER_COUNT ) ?
+                stream_.GetQueuedBufferMaximum() :
+                BUFFER_COUNT;
+
+    // Create, alloc buffers
+    buffers_ = new PvBuffer[ buffer_count_ ];
+    for ( PvUInt32 i = 0; i < buffer_count_; i++ )
+    {
+        buffers_[ i ].Alloc( static_cast<PvUInt32>( lSize ) );
+    }
+
+    // Have to set the Device IP destination to the Stream
+    device_->SetStreamDestination( stream_.GetLocalIPAddress(), stream_.GetLocalPort() );
+
+    // Queue all buffers in the stream
+    for ( PvUInt32 i = 0; i < buffer_count_; i++ )
+    {
+        stream_.QueueBuffer( buffers_ + i );
+    }
+
+    ROS_INFO("Resetting timestamp counter.");
+    PvGenCommand *lResetTimestamp = dynamic_cast<PvGenCommand *>( device_params_->Get( "GevTimestampControlReset" ) );
+    lResetTimestamp->Execute();
+
+    // the device timestamps are mapped to ROS time by the image pipeline
+    tick_frequency_ = 0.0;
+    PvInt64 lTickFrequency = 0;
+    PvGenInteger *lTimestampTickFrequency = dynamic_cast<PvGenInteger *>( device_params_->Get( "GevTimestampTickFrequency" ) );
+    if ( lTimestampTickFrequency != NULL && lTimestampTickFrequency->GetValue( lTickFrequency ).IsOK() && lTickFrequency > 0 )
+        tick_frequency_ = (double) lTickFrequency;
+
+    // The buffers are queued in the stream, we just have to tell the device
+    // to start sending us images
+    ROS_INFO("4. Sending StartAcquisition command to device.");
+    PvGenCommand *lStart = dynamic_cast<PvGenCommand *>( device_params_->Get( "AcquisitionStart" ) );
+    return lStart->Execute().IsOK();
+}
+
+void Ebus_Frame_Source::stop()
+{
+    if (buffers_ == NULL)
+        return;
+
+    // Clean-up
+    // Tell the device to stop sending images
+    ROS_INFO("Sending AcquisitionStop command to the device.");
+    PvGenCommand* lStop = dynamic_cast<PvGenCommand *>( device_params_->Get( "AcquisitionStop" ) );
+    lStop->Execute();
+
+    // Abort all buffers from the stream, unqueue
+    ROS_INFO("Aborting buffers still in stream.");
+    stream_.AbortQueuedBuffers();
+    while ( stream_.GetQueuedBufferCount() > 0 )
+    {
+        PvBuffer *lBuffer = NULL;
+        PvResult lOperationResult;
+
+        stream_.RetrieveBuffer( &lBuffer, &lOperationResult );
+
+        ROS_INFO("Post-abort retrieved buffer: %s", lOperationResult.GetCodeString().GetAscii());
+    }
+
+    // Release buffers
+    ROS_INFO("Releasing buffers.");
+    delete []buffers_;
+    buffers_ = NULL;
+    retrieved_buffer_ = NULL;
+
+    // Now close the stream. Also optionnal but nice to have
+    ROS_INFO("Closing stream.");
+    stream_.Close();
+}
+
+bool Ebus_Frame_Source::retrieve(Frame& frame, unsigned int timeout)
+{
+    PvBuffer *lBuffer = NULL;
+    PvResult lOperationResult;
+
+    // Retrieve next buffer
+    PvResult lRetrieveResult = stream_.RetrieveBuffer( &lBuffer, &lOperationResult, timeout );
+    if ( !lRetrieveResult.IsOK() )
+    {
+        if ( lRetrieveResult.GetCode() != PvResult::Code::TIMEOUT )
+            ROS_WARN_THROTTLE(1, "Could not retrieve buffer. %s", lRetrieveResult.GetCodeString().GetAscii());
+        return false;
+    }
+
+    if ( !lOperationResult.IsOK() || lBuffer->GetPayloadType() != PvPayloadTypeImage )
+    {
+        if ( !lOperationResult.IsOK() )
+            ROS_WARN("Operation unsuccessful. %s %s", lOperationResult.GetCodeString().GetAscii(), lOperationResult.GetDescription().GetAscii());
+
+        // re-queue the buffer in the stream object
+        stream_.QueueBuffer( lBuffer );
+        return false;
+    }
+
+    // Get image specific buffer interface
+    PvImage *Image = lBuffer->GetImage();
+    frame.data = Image->GetDataPointer();
+    frame.size = Image->GetImageSize();
+    frame.width = (int) Image->GetWidth();
+    frame.height = (int) Image->GetHeight();
+    frame.step = frame.width * 2 + (int) Image->GetPaddingX();
+    frame.timestamp = lBuffer->GetTimestamp();
+
+    retrieved_buffer_ = lBuffer;
+    return true;
+}
+
+// re-queue the retrieved buffer in the stream object
+void Ebus_Frame_Source::release()
+{
+    if (retrieved_buffer_ != NULL)
+    {
+        stream_.QueueBuffer( retrieved_buffer_ );
+        retrieved_buffer_ = NULL;
+    }
+}
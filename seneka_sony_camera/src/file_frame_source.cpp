@@ -0,0 +1,350 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#include "file_frame_source.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <boost/thread.hpp>
+
+#include <ros/ros.h>
+
+// pcap file format
+#define PCAP_MAGIC ( 0xa1b2c3d4 )
+#define PCAP_MAGIC_NSEC ( 0xa1b23c4d )
+#define PCAP_GLOBAL_HEADER_SIZE ( 24 )
+#define PCAP_RECORD_HEADER_SIZE ( 16 )
+#define PCAP_LINKTYPE_ETHERNET ( 1 )
+#define PCAP_LINKTYPE_LINUX_SLL ( 113 )
+
+// GigE Vision stream protocol
+#define GVSP_HEADER_SIZE ( 8 )
+#define GVSP_FORMAT_LEADER ( 1 )
+#define GVSP_FORMAT_TRAILER ( 2 )
+#define GVSP_FORMAT_PAYLOAD ( 3 )
+#define GVSP_PAYLOAD_TYPE_IMAGE ( 1 )
+#define GVSP_PIXEL_FORMAT_YUV422_UYVY ( 0x0210001F )
+
+static uint16_t readBigEndian16(const unsigned char* data)
+{
+    return (uint16_t)((data[0] << 8) | data[1]);
+}
+
+static uint32_t readBigEndian32(const unsigned char* data)
+{
+    return ((uint32_t) data[0] << 24) | ((uint32_t) data[1] << 16) | ((uint32_t) data[2] << 8) | data[3];
+}
+
+static uint32_t swap32(uint32_t value)
+{
+    return (value >> 24) | ((value >> 8) & 0xff00) | ((value << 8) & 0xff0000) | (value << 24);
+}
+
+// constructor
+File_Frame_Source::File_Frame_Source(const std::string& file_name, int width, int height, double rate, bool loop)
+{
+    file_name_ = file_name;
+    width_ = width;
+    height_ = height;
+    rate_ = rate;
+    loop_ = loop;
+    pcap_ = false;
+    swapped_ = false;
+    link_type_ = 0;
+    frame_width_ = 0;
+    frame_height_ = 0;
+    incomplete_frames_ = 0;
+}
+
+// destructor
+File_Frame_Source::~File_Frame_Source()
+{
+    stop();
+}
+
+bool File_Frame_Source::start()
+{
+    file_.open(file_name_.c_str(), std::ios::in | std::ios::binary);
+    if (!file_.is_open())
+    {
+        ROS_ERROR("Could not open %s.", file_name_.c_str());
+        return false;
+    }
+
+    // pcap files are detected by their magic number, everything else is raw
+    uint32_t header[PCAP_GLOBAL_HEADER_SIZE / 4];
+    file_.read((char*) header, sizeof(header));
+    pcap_ = false;
+    if (file_.good())
+    {
+        if (header[0] == PCAP_MAGIC || header[0] == PCAP_MAGIC_NSEC)
+            pcap_ = true;
+        else if (header[0] == swap32(PCAP_MAGIC) || header[0] == swap32(PCAP_MAGIC_NSEC))
+            pcap_ = swapped_ = true;
+    }
+
+    if (pcap_)
+    {
+        link_type_ = swapped_ ? swap32(header[5]) : header[5];
+        if (link_type_ != PCAP_LINKTYPE_ETHERNET && link_type_ != PCAP_LINKTYPE_LINUX_SLL)
+        {
+            ROS_ERROR("Link type %u of %s is not supported.", link_type_, file_name_.c_str());
+            file_.close();
+            return false;
+        }
+        first_record_ = PCAP_GLOBAL_HEADER_SIZE;
+        ROS_INFO("Replaying the GigE Vision stream captured in %s.", file_name_.c_str());
+    }
+    else
+    {
+        if (width_ <= 0 || height_ <= 0)
+        {
+            ROS_ERROR("The frame size of the raw file %s is not set.", file_name_.c_str());
+            file_.close();
+            return false;
+        }
+        first_record_ = 0;
+        frame_width_ = width_;
+        frame_height_ = height_;
+        frame_.resize((size_t) width_ * height_ * 2);
+        ROS_INFO("Replaying the raw %dx%d UYVY frames of %s.", width_, height_, file_name_.c_str());
+    }
+
+    incomplete_frames_ = 0;
+    next_frame_ = boost::posix_time::ptime();
+    return rewind();
+}
+
+void File_Frame_Source::stop()
+{
+    if (file_.is_open())
+        file_.close();
+}
+
+bool File_Frame_Source::retrieve(Frame& frame, unsigned int timeout)
+{
+    if (!file_.is_open() || !waitForFrame(rate_, timeout))
+        return false;
+
+    bool read = pcap_ ? readPcapFrame() : readRawFrame();
+
+    // start again at the beginning of the file
+    if (!read && loop_ && rewind())
+        read = pcap_ ? readPcapFrame() : readRawFrame();
+
+    if (!read)
+    {
+        ROS_INFO_ONCE("Reached the end of %s.", file_name_.c_str());
+        boost::this_thread::sleep(boost::posix_time::milliseconds(timeout));
+        return false;
+    }
+
+    frame.data = &frame_[0];
+    frame.size = frame_.size();
+    frame.width = frame_width_;
+    frame.height = frame_height_;
+    frame.step = frame_width_ * 2;
+    frame.timestamp = 0;
+    return true;
+}
+
+void File_Frame_Source::release()
+{
+}
+
+bool File_Frame_Source::rewind()
+{
+    file_.clear();
+    file_.seekg(first_record_);
+    return file_.good();
+}
+
+bool File_Frame_Source::readRawFrame()
+{
+    file_.read((char*) &frame_[0], frame_.size());
+    return file_.gcount() == (std::streamsize) frame_.size();
+}
+
+// reads the next UDP payload out of the capture, false at the end of the file
+bool File_Frame_Source::readPcapPacket(std::vector<unsigned char>& packet)
+{
+    while (true)
+    {
+        uint32_t record[PCAP_RECORD_HEADER_SIZE / 4];
+        file_.read((char*) record, sizeof(record));
+        if (!file_.good())
+            return false;
+
+        uint32_t length = swapped_ ? swap32(record[2]) : record[2];
+        packet_.resize(length);
+        if (length > 0)
+            file_.read((char*) &packet_[0], length);
+        if (!file_.good())
+            return false;
+
+        // link layer header
+        size_t offset;
+        uint16_t ether_type;
+        if (link_type_ == PCAP_LINKTYPE_ETHERNET)
+        {
+            if (length < 14)
+                continue;
+            ether_type = readBigEndian16(&packet_[12]);
+            offset = 14;
+            if (ether_type == 0x8100 && length >= 18)
+            {
+                ether_type = readBigEndian16(&packet_[16]);
+                offset = 18;
+            }
+        }
+        else
+        {
+            if (length < 16)
+                continue;
+            ether_type = readBigEndian16(&packet_[14]);
+            offset = 16;
+        }
+
+        // IPv4 and UDP header
+        if (ether_type != 0x0800 || length < offset + 20 || (packet_[offset] >> 4) != 4 || packet_[offset + 9] != 17)
+            continue;
+        offset += (packet_[offset] & 0x0f) * 4;
+        if (length < offset + 8)
+            continue;
+
+        uint16_t udp_length = readBigEndian16(&packet_[offset + 4]);
+        if (udp_length < 8 || offset + udp_length > length)
+            continue;
+
+        packet.assign(packet_.begin() + offset + 8, packet_.begin() + offset + udp_length);
+        return true;
+    }
+}
+
+// reassembles the next complete frame, incomplete frames are skipped
+bool File_Frame_Source::readPcapFrame()
+{
+    std::vector<unsigned char> packet;
+    bool in_frame = false;
+    uint16_t block_id = 0;
+    size_t packet_size = 0;
+    size_t received = 0;
+
+    while (readPcapPacket(packet))
+    {
+        if (packet.size() < GVSP_HEADER_SIZE)
+            continue;
+
+        uint16_t packet_block_id = readBigEndian16(&packet[2]);
+        unsigned int format = packet[4] & 0x0f;
+        uint32_t packet_id = readBigEndian32(&packet[4]) & 0x00ffffff;
+        const unsigned char* data = &packet[GVSP_HEADER_SIZE];
+        size_t size = packet.size() - GVSP_HEADER_SIZE;
+
+        if (format == GVSP_FORMAT_LEADER)
+        {
+            if (in_frame)
+                incomplete_frames_++;
+            in_frame = false;
+
+            if (size < 36 || readBigEndian16(&data[2]) != GVSP_PAYLOAD_TYPE_IMAGE)
+                continue;
+            if (readBigEndian32(&data[12]) != GVSP_PIXEL_FORMAT_YUV422_UYVY)
+            {
+                ROS_WARN_ONCE("Skipping frames which are not in the UYVY pixel format.");
+                continue;
+            }
+
+            frame_width_ = (int) readBigEndian32(&data[16]);
+            frame_height_ = (int) readBigEndian32(&data[20]);
+            frame_.resize((size_t) frame_width_ * frame_height_ * 2);
+            block_id = packet_block_id;
+            packet_size = 0;
+            received = 0;
+            in_frame = true;
+        }
+        else if (in_frame && packet_block_id == block_id && format == GVSP_FORMAT_PAYLOAD && packet_id > 0)
+        {
+            // all payload packets but the last one have the same size
+            if (packet_size == 0)
+                packet_size = size;
+
+            size_t offset = (packet_id - 1) * packet_size;
+            if (offset < frame_.size())
+            {
+                size_t count = std::min(size, frame_.size() - offset);
+                memcpy(&frame_[offset], data, count);
+                received += count;
+            }
+        }
+        else if (in_frame && packet_block_id == block_id && format == GVSP_FORMAT_TRAILER)
+        {
+            in_frame = false;
+            if (received == frame_.size())
+                return true;
+
+            incomplete_frames_++;
+            ROS_WARN_THROTTLE(10, "Skipped %lu incomplete frames of the capture.", incomplete_frames_);
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,158 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#include "frame_preview.h"
+
+#include <boost/bind.hpp>
+
+// constructor
+Frame_Preview::Frame_Preview(const std::string& window_name, double max_rate)
+{
+    window_name_ = window_name;
+    min_interval_ = boost::posix_time::microseconds(max_rate > 0 ? (long)(1000000 / max_rate) : 0);
+    frame_available_ = false;
+    running_ = false;
+}
+
+// destructor
+Frame_Preview::~Frame_Preview()
+{
+    stop();
+}
+
+// start the display thread
+void Frame_Preview::start()
+{
+    if (!running_)
+    {
+        running_ = true;
+        display_thread_ = boost::thread(boost::bind(&Frame_Preview::display, this));
+    }
+}
+
+// stop the display thread and close the window
+void Frame_Preview::stop()
+{
+    if (running_)
+    {
+        {
+            boost::mutex::scoped_lock lock(mailbox_mutex_);
+            running_ = false;
+        }
+        mailbox_condition_.notify_one();
+        display_thread_.join();
+    }
+}
+
+// hand a frame over to the display thread, never waits for the GUI
+void Frame_Preview::show(const cv::Mat& frame)
+{
+    if (!running_ || frame.empty())
+        return;
+
+    // rate limit before copying the frame
+    boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+    if (!last_accepted_.is_not_a_date_time() && now - last_accepted_ < min_interval_)
+        return;
+    last_accepted_ = now;
+
+    // the caller reuses the frame memory, so the mailbox gets its own copy
+    cv::Mat copy = frame.clone();
+    {
+        boost::mutex::scoped_lock lock(mailbox_mutex_);
+        mailbox_ = copy;    // a frame which was not displayed yet is dropped
+        frame_available_ = true;
+    }
+    mailbox_condition_.notify_one();
+}
+
+// display thread: all highgui calls are done in this thread
+void Frame_Preview::display()
+{
+    cv::namedWindow(window_name_, cv::WINDOW_AUTOSIZE);
+
+    while (true)
+    {
+        cv::Mat frame;
+        {
+            boost::mutex::scoped_lock lock(mailbox_mutex_);
+            if (running_ && !frame_available_)
+                mailbox_condition_.timed_wait(lock, boost::posix_time::milliseconds(100));
+
+            if (!running_)
+                break;
+
+            if (frame_available_)
+            {
+                frame = mailbox_;
+                mailbox_ = cv::Mat();
+                frame_available_ = false;
+            }
+        }
+
+        if (!frame.empty())
+            cv::imshow(window_name_, frame);
+
+        // also keeps the window responsive if no frames arrive
+        cv::waitKey(1);
+    }
+
+    cv::destroyWindow(window_name_);
+}
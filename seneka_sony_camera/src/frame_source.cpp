@@ -0,0 +1,97 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#include "frame_source.h"
+
+#include <boost/thread.hpp>
+
+// constructor
+Frame_Source::Frame_Source()
+{
+}
+
+// destructor
+Frame_Source::~Frame_Source()
+{
+}
+
+// paces the stand-in sources, a rate of 0 delivers the frames as fast as possible
+bool Frame_Source::waitForFrame(double rate, unsigned int timeout)
+{
+    if (rate <= 0)
+        return true;
+
+    boost::posix_time::time_duration interval = boost::posix_time::microseconds((long)(1000000 / rate));
+    boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+
+    // after a stall the frames are not delivered in a burst to catch up
+    if (next_frame_.is_not_a_date_time() || next_frame_ + interval < now)
+        next_frame_ = now;
+
+    if (next_frame_ - now > boost::posix_time::milliseconds(timeout))
+    {
+        boost::this_thread::sleep(now + boost::posix_time::milliseconds(timeout));
+        return false;
+    }
+
+    boost::this_thread::sleep(next_frame_);
+    next_frame_ += interval;
+    return true;
+}
@@ -0,0 +1,536 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#include "image_pipeline.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#include <boost/bind.hpp>
+
+// timeout of retrieving a frame in ms, only used to notice the end of the acquisition
+#define RETRIEVE_TIMEOUT ( 1000 )
+
+// published images which can be in use by subscribers at the same time
+#define IMAGE_POOL_SIZE ( 4 )
+
+// capture-to-publish latency histogram, bin width in s and number of bins
+#define LATENCY_BIN_WIDTH ( 0.001 )
+#define LATENCY_BINS ( 200 )
+
+// constructor
+Image_Pipeline::Image_Pipeline(ros::NodeHandle& nh, ros::NodeHandle& pnh):it(nh)
+{
+    // publish images
+    publish_rgb_image               =   it.advertise(       "SonyGigCam_rgb_image", 10);
+    publish_raw_image               =   it.advertise(       "SonyGigCam_yuv_image", 10);
+    publish_jpeg_image              =   nh.advertise<sensor_msgs::CompressedImage>("SonyGigCam_jpeg/compressed", 10);
+    publish_latency                 =   nh.advertise<seneka_msg::LatencyHistogram>("SonyGigCam_latency", 1);
+
+    // read parameter from parameter server
+    // if parameter not found, use default value
+    if(!pnh.hasParam("debug_screen"))
+        ROS_WARN("Using default value for initial debug_screen parameter [false].");
+    pnh.param("debug_screen",debug_screen_param, false);
+
+    // read parameter from parameter server
+    // if parameter not found, use default value
+    if(!pnh.hasParam("debug_screen_rate"))
+        ROS_WARN("Using default value for initial debug_screen_rate parameter [10.0].");
+    pnh.param("debug_screen_rate",debug_screen_rate_param, 10.0);
+
+    // the debug screen is shown by its own thread, so it never slows down the image publisher
+    preview_ = new Frame_Preview("Sony", debug_screen_rate_param);
+
+    if(!pnh.hasParam("conversion_threads"))
+        ROS_WARN("Using default value for initial conversion_threads parameter [0].");
+    pnh.param("conversion_threads",conversion_threads_param, 0);
+
+    // the color conversion is split into row bands, 0 uses one thread per core
+    conversion_pool_ = new RowBandPool(conversion_threads_param > 0 ? conversion_threads_param : 0);
+    ROS_INFO("Converting images with %u threads.", conversion_pool_->threads());
+
+    if(!pnh.hasParam("timestamp_offset"))
+        ROS_WARN("Using default value for initial timestamp_offset parameter [0.0].");
+    pnh.param("timestamp_offset",timestamp_offset_param, 0.0);
+
+    if(!pnh.hasParam("clock_window"))
+        ROS_WARN("Using default value for initial clock_window parameter [900].");
+    pnh.param("clock_window",clock_window_param, 900);
+
+    if(!pnh.hasParam("latency_period"))
+        ROS_WARN("Using default value for initial latency_period parameter [10.0].");
+    pnh.param("latency_period",latency_period_param, 10.0);
+
+    // the clock mapper is created by start, the device clock is reset by the source
+    source_ = NULL;
+    clock_mapper_ = NULL;
+    clock_drift_ = 0.0;
+    latency_histogram_ = new Latency_Histogram(LATENCY_BIN_WIDTH, LATENCY_BINS);
+    latency_published_ = ros::Time::now();
+
+    if(!pnh.hasParam("preview_scale"))
+        ROS_WARN("Using default value for initial preview_scale parameter [4].");
+    pnh.param("preview_scale",preview_scale_param, 4);
+
+    if(preview_scale_param != 0 && preview_scale_param < 2)
+    {
+        ROS_ERROR("The preview_scale parameter must be 0 or at least 2, using 4.");
+        preview_scale_param = 4;
+    }
+
+    // the downscaled preview is only advertised if it is enabled
+    if(preview_scale_param > 0)
+        publish_preview_image       =   it.advertise(       "SonyGigCam_preview_image", 10);
+
+    if(!pnh.hasParam("regions_of_interest"))
+        ROS_WARN("Using default value for initial regions_of_interest parameter [].");
+    pnh.param("regions_of_interest",regions_of_interest_param, std::string(""));
+
+    if(!parseRegions(regions_of_interest_param))
+    {
+        ROS_ERROR("Invalid regions_of_interest parameter [%s], expected \"x,y,width,height;...\".", regions_of_interest_param.c_str());
+        regions_.clear();
+    }
+
+    // one topic and one image pool per region of interest
+    for(size_t i = 0; i < regions_.size(); i++)
+    {
+        std::ostringstream topic;
+        topic << "SonyGigCam_roi_image_" << i;
+        publish_roi_images.push_back(it.advertise(topic.str(), 10));
+        roi_pools_.push_back(new Image_Pool(IMAGE_POOL_SIZE));
+        ROS_INFO("Publishing region %d,%d %dx%d on %s.", regions_[i].x, regions_[i].y, regions_[i].width, regions_[i].height, topic.str().c_str());
+    }
+
+    if(!pnh.hasParam("jpeg_threads"))
+        ROS_WARN("Using default value for initial jpeg_threads parameter [2].");
+    pnh.param("jpeg_threads",jpeg_threads_param, 2);
+
+    if(!pnh.hasParam("jpeg_quality"))
+        ROS_WARN("Using default value for initial jpeg_quality parameter [80].");
+    pnh.param("jpeg_quality",jpeg_quality_param, 80);
+
+    if(jpeg_quality_param < 1 || jpeg_quality_param > 100)
+    {
+        ROS_ERROR("The jpeg_quality parameter must be in-between 1 and 100, using 80.");
+        jpeg_quality_param = 80;
+    }
+
+    // every encoder thread compresses whole frames, 0 uses one thread per core
+    jpeg_encoder_ = new Jpeg_Encoder(jpeg_threads_param > 0 ? jpeg_threads_param : 0, jpeg_quality_param,
+                                     boost::bind(&Image_Pipeline::publishJpeg, this, _1, _2));
+
+    image_pool_ = new Image_Pool(IMAGE_POOL_SIZE);
+    // the encoder holds the raw images of the frames it compresses
+    raw_image_pool_ = new Image_Pool(IMAGE_POOL_SIZE + jpeg_encoder_->getMaxFrames());
+    preview_pool_ = new Image_Pool(IMAGE_POOL_SIZE);
+
+    acquiring_ = false;
+    dropped_frames_ = 0;
+    if(debug_screen_param)
+        preview_->start();
+}
+
+// destructor
+Image_Pipeline::~Image_Pipeline()
+{
+    stop();
+
+    delete jpeg_encoder_;
+    delete preview_;
+    delete image_pool_;
+    delete raw_image_pool_;
+    delete preview_pool_;
+    for(size_t i = 0; i < roi_pools_.size(); i++)
+        delete roi_pools_[i];
+    delete conversion_pool_;
+    delete clock_mapper_;
+    delete latency_histogram_;
+}
+
+// starts the source and the acquisition and processing threads
+bool Image_Pipeline::start(Frame_Source* source)
+{
+    if (acquiring_)
+    {
+        ROS_WARN("Streaming is already running.");
+        return false;
+    }
+
+    source_ = source;
+    if (!source_->start())
+    {
+        ROS_ERROR("Could not start the frame source.");
+        source_->stop();
+        return false;
+    }
+
+    // the device timestamps are mapped to ROS time, starting again with the reset counter
+    {
+        boost::mutex::scoped_lock lock(latency_mutex_);
+        delete clock_mapper_;
+        clock_mapper_ = NULL;
+        clock_drift_ = 0.0;
+        if (source_->getTickFrequency() > 0)
+            clock_mapper_ = new Clock_Mapper(source_->getTickFrequency(), clock_window_param);
+        else
+            ROS_WARN("The frames have no device timestamps, images are stamped with their arrival time.");
+    }
+
+    // images are retrieved and published by their own threads
+    acquiring_ = true;
+    pending_frame_.reset();
+    dropped_frames_ = 0;
+    acquisition_thread_ = boost::thread(boost::bind(&Image_Pipeline::acquireImages, this));
+    processing_thread_ = boost::thread(boost::bind(&Image_Pipeline::processImages, this));
+    return true;
+}
+
+void Image_Pipeline::stop()
+{
+    if (!acquiring_)
+        return;
+
+    // stop the acquisition and processing threads before the source is stopped
+    {
+        boost::mutex::scoped_lock lock(frame_mutex_);
+        acquiring_ = false;
+    }
+    frame_condition_.notify_all();
+    acquisition_thread_.join();
+    processing_thread_.join();
+
+    // no JPEG image is published after the streaming has been stopped
+    jpeg_encoder_->flush();
+
+    source_->stop();
+    source_ = NULL;
+}
+
+// Acquisition thread: blocks on the source and releases every frame
+// immediately after it has been copied
+void Image_Pipeline::acquireImages()
+{
+    while (acquiring_)
+    {
+        Frame_Source::Frame frame;
+        if (!source_->retrieve(frame, RETRIEVE_TIMEOUT))
+            continue;
+
+        // the rows may be padded, but the last row has to be complete
+        size_t row_size = (size_t) frame.width * 2;
+        if (frame.width <= 0 || frame.height <= 0 || frame.step < (int) row_size ||
+            frame.size < (size_t) frame.step * (frame.height - 1) + row_size)
+        {
+            ROS_WARN_THROTTLE(10, "Dropping a frame of %dx%d pixels with %d bytes per row and only %lu bytes.",
+                              frame.width, frame.height, frame.step, (unsigned long) frame.size);
+            source_->release();
+            continue;
+        }
+
+        // the device timestamp is latched by the camera, the arrival time
+        // additionally contains the transfer and the buffer handling
+        ros::Time stamp = ros::Time::now();
+        if (clock_mapper_ != NULL)
+        {
+            stamp = clock_mapper_->update(frame.timestamp, stamp);
+
+            // the drift is logged by recordLatency, which also runs on the encoder threads
+            boost::mutex::scoped_lock lock(latency_mutex_);
+            clock_drift_ = clock_mapper_->getDrift();
+        }
+        stamp = stamp - ros::Duration(timestamp_offset_param);
+
+        // copy the native YUV 4:2:2 image into a pooled message
+        sensor_msgs::ImagePtr raw = raw_image_pool_->acquire(frame.width, frame.height, frame.width * 2, sensor_msgs::image_encodings::YUV422);
+        raw->header.stamp = stamp;
+        raw->header.frame_id = "sony_image_view";
+        if (frame.step == (int) row_size)
+            memcpy(&raw->data[0], frame.data, raw->data.size());
+        else
+            for (int row = 0; row < frame.height; row++)
+                memcpy(&raw->data[row * row_size], frame.data + (size_t) row * frame.step, row_size);
+
+        source_->release();
+
+        // hand the image over, a frame which was not processed yet is dropped
+        {
+            boost::mutex::scoped_lock lock(frame_mutex_);
+            if (pending_frame_)
+                dropped_frames_++;
+            pending_frame_ = raw;
+        }
+        frame_condition_.notify_one();
+    }
+}
+
+// Processing thread: publishes every image as soon as it arrives
+void Image_Pipeline::processImages()
+{
+    while (true)
+    {
+        sensor_msgs::ImagePtr raw;
+        {
+            boost::mutex::scoped_lock lock(frame_mutex_);
+            while (acquiring_ && !pending_frame_)
+                frame_condition_.wait(lock);
+
+            if (!acquiring_)
+                break;
+
+            raw.swap(pending_frame_);
+
+            if (dropped_frames_ > 0)
+            {
+                ROS_WARN_THROTTLE(10, "Processing is too slow, dropped %lu frames.", dropped_frames_);
+            }
+        }
+
+        publishImage(raw);
+    }
+}
+
+// Image publisher: the native image is published as it is, the RGB images
+// are only converted if somebody uses them
+void Image_Pipeline::publishImage(const sensor_msgs::ImageConstPtr& raw)
+{
+    bool publish_raw = publish_raw_image.getNumSubscribers() > 0;
+    if (publish_raw)
+        publish_raw_image.publish(raw);
+
+    Conversion conversion;
+    sensor_msgs::ImagePtr img, preview;
+    std::vector<sensor_msgs::ImagePtr> rois(regions_.size());
+
+    bool publish_rgb = publish_rgb_image.getNumSubscribers() > 0;
+    conversion.rgb = NULL;
+    if (publish_rgb || debug_screen_param)
+    {
+        // Converting YUV image formate to RGB, directly into the data of a pooled message
+        img = image_pool_->acquire(raw->width, raw->height, raw->width * 3, sensor_msgs::image_encodings::RGB8);
+        img->header = raw->header;
+        conversion.rgb = img.get();
+    }
+
+    conversion.preview = NULL;
+    if (preview_scale_param > 0 && publish_preview_image.getNumSubscribers() > 0)
+    {
+        int width = raw->width / preview_scale_param;
+        int height = raw->height / preview_scale_param;
+        preview = preview_pool_->acquire(width, height, width * 3, sensor_msgs::image_encodings::RGB8);
+        preview->header = raw->header;
+        conversion.preview = preview.get();
+    }
+
+    for (size_t i = 0; i < regions_.size(); i++)
+    {
+        conversion.rois.push_back(NULL);
+        conversion.regions.push_back(Region());
+        if (publish_roi_images[i].getNumSubscribers() == 0)
+            continue;
+
+        // clip the region to the image, pixel pairs share their color so x and width are even
+        Region& r = conversion.regions[i];
+        r.x = std::min(regions_[i].x, (int) raw->width) & ~1;
+        r.y = std::min(regions_[i].y, (int) raw->height);
+        r.width = (std::min(regions_[i].x + regions_[i].width, (int) raw->width) - r.x) & ~1;
+        r.height = std::min(regions_[i].y + regions_[i].height, (int) raw->height) - r.y;
+        if (r.width <= 0 || r.height <= 0)
+        {
+            ROS_WARN_THROTTLE(10, "Region of interest %d is outside of the image.", (int) i);
+            continue;
+        }
+
+        rois[i] = roi_pools_[i]->acquire(r.width, r.height, r.width * 3, sensor_msgs::image_encodings::RGB8);
+        rois[i]->header = raw->header;
+        conversion.rois[i] = rois[i].get();
+    }
+
+    bool publish_roi = false;
+    for (size_t i = 0; i < rois.size(); i++)
+        publish_roi = publish_roi || rois[i];
+
+    // the JPEG image is compressed by the encoder threads, frames are skipped while they are busy;
+    // a frame which is only published as JPEG image is recorded by publishJpeg
+    bool published = publish_raw || publish_rgb || preview || publish_roi;
+    bool publish_jpeg = publish_jpeg_image.getNumSubscribers() > 0;
+    if (publish_jpeg && !jpeg_encoder_->encode(raw, !published))
+        ROS_WARN_THROTTLE(10, "JPEG encoding is too slow, skipped %lu frames.", jpeg_encoder_->getSkippedFrames());
+
+    // a single pass over the row bands of the raw image
+    if (img || preview || publish_roi)
+        conversion_pool_->run(raw->height, boost::bind(&Image_Pipeline::convertRows, this, raw.get(), &conversion, _1, _2));
+
+    if (publish_rgb)
+        publish_rgb_image.publish(img);
+    if (preview)
+        publish_preview_image.publish(preview);
+    for (size_t i = 0; i < rois.size(); i++)
+        if (rois[i])
+            publish_roi_images[i].publish(rois[i]);
+
+    if (published)
+        recordLatency(raw->header.stamp);
+
+    if (debug_screen_param)
+        preview_->show(cv::Mat(img->height, img->width, CV_8UC3, &img->data[0], img->step));
+}
+
+// Called by the encoder threads in the order of the frames
+void Image_Pipeline::publishJpeg(const sensor_msgs::CompressedImagePtr& compressed, bool record_latency)
+{
+    publish_jpeg_image.publish(compressed);
+
+    if (record_latency)
+        recordLatency(compressed->header.stamp);
+}
+
+// Adds the capture-to-publish latency of a frame, the histogram is published
+// and cleared every latency_period seconds
+void Image_Pipeline::recordLatency(const ros::Time& stamp)
+{
+    boost::mutex::scoped_lock lock(latency_mutex_);
+
+    ros::Time now = ros::Time::now();
+    latency_histogram_->add((now - stamp).toSec());
+
+    if ((now - latency_published_).toSec() < latency_period_param)
+        return;
+
+    seneka_msg::LatencyHistogram msg;
+    msg.header.stamp = now;
+    msg.header.frame_id = "sony_image_view";
+    latency_histogram_->toMsg(msg);
+    publish_latency.publish(msg);
+
+    if (clock_mapper_ != NULL)
+        ROS_DEBUG("Mean latency %.1f ms, camera clock drift %.1f ppm.", msg.mean * 1000.0, clock_drift_ * 1e6);
+
+    latency_histogram_->reset();
+    latency_published_ = now;
+}
+
+// Converts the rows [begin, end) of the raw image into all images of the
+// conversion, called by the conversion pool
+void Image_Pipeline::convertRows(const sensor_msgs::Image* raw, const Conversion* conversion, int begin, int end)
+{
+    if (conversion->rgb != NULL)
+    {
+        sensor_msgs::Image* img = conversion->rgb;
+        yuvToRgb(&raw->data[(size_t) begin * raw->step], raw->step,
+                 &img->data[(size_t) begin * img->step], img->step,
+                 raw->width, end - begin);
+    }
+
+    // preview rows whose first source row is in this band
+    if (conversion->preview != NULL)
+    {
+        sensor_msgs::Image* preview = conversion->preview;
+        int scale = preview_scale_param;
+        int first = (begin + scale - 1) / scale;
+        int last = std::min((end + scale - 1) / scale, (int) preview->height);
+        if (last > first)
+            yuvToRgbDownscaled(&raw->data[(size_t) first * scale * raw->step], raw->step,
+                               &preview->data[(size_t) first * preview->step], preview->step,
+                               raw->width, last - first, scale);
+    }
+
+    for (size_t i = 0; i < conversion->rois.size(); i++)
+    {
+        sensor_msgs::Image* roi = conversion->rois[i];
+        if (roi == NULL)
+            continue;
+
+        const Region& r = conversion->regions[i];
+        int first = std::max(begin, r.y);
+        int last = std::min(end, r.y + r.height);
+        if (last > first)
+            yuvToRgb(&raw->data[(size_t) first * raw->step + r.x * 2], raw->step,
+                     &roi->data[(size_t) (first - r.y) * roi->step], roi->step,
+                     r.width, last - first);
+    }
+}
+
+// Parses "x,y,width,height" regions separated by semicolons
+bool Image_Pipeline::parseRegions(const std::string& str)
+{
+    regions_.clear();
+
+    std::istringstream regions(str);
+    std::string item;
+    while (std::getline(regions, item, ';'))
+    {
+        if (item.find_first_not_of(" \t") == std::string::npos)
+            continue;
+
+        Region r;
+        char c1, c2, c3;
+        std::istringstream values(item);
+        if (!(values >> r.x >> c1 >> r.y >> c2 >> r.width >> c3 >> r.height) ||
+            c1 != ',' || c2 != ',' || c3 != ',' ||
+            r.x < 0 || r.y < 0 || r.width < 2 || r.height < 1)
+            return false;
+
+        regions_.push_back(r);
+    }
+    return true;
+}
@@ -0,0 +1,110 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#include "image_pool.h"
+
+#include <ros/ros.h>
+#include <boost/make_shared.hpp>
+
+// constructor
+Image_Pool::Image_Pool(size_t max_images)
+{
+    max_images_ = max_images;
+    images_.reserve(max_images_);
+}
+
+// destructor, images still used by subscribers are released by them
+Image_Pool::~Image_Pool()
+{
+}
+
+// returns an image with allocated data of height * step bytes, the content
+// of the data and the header is undefined
+sensor_msgs::ImagePtr Image_Pool::acquire(int width, int height, int step, const std::string& encoding)
+{
+    sensor_msgs::ImagePtr image;
+
+    // look for an image which is not used anymore
+    for (size_t i = 0; i < images_.size() && !image; i++)
+    {
+        if (images_[i].unique())
+            image = images_[i];
+    }
+
+    if (!image)
+    {
+        image = boost::make_shared<sensor_msgs::Image>();
+        if (images_.size() < max_images_)
+            images_.push_back(image);
+        else
+            ROS_WARN_THROTTLE(10, "All %d pooled images are in use, allocating an additional image.", (int)max_images_);
+    }
+
+    image->width = width;
+    image->height = height;
+    image->step = step;
+    image->encoding = encoding;
+    image->is_bigendian = 0;
+
+    // only reallocated if the image size changes
+    image->data.resize((size_t)height * step);
+
+    return image;
+}
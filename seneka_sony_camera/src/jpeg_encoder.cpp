@@ -0,0 +1,219 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#include "jpeg_encoder.h"
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+
+#include <opencv2/opencv.hpp>
+
+#include "yuv_converter.h"
+
+// constructor, threads: number of encoding threads, 0 uses one thread per core
+Jpeg_Encoder::Jpeg_Encoder(unsigned int threads, int quality, const Publish_Callback& callback)
+{
+    if (threads == 0)
+        threads = boost::thread::hardware_concurrency();
+    if (threads == 0)
+        threads = 1;
+
+    callback_ = callback;
+    quality_ = quality;
+
+    // one frame waiting for every busy worker
+    max_frames_ = 2 * threads;
+
+    running_ = true;
+    next_sequence_ = 0;
+    next_emit_ = 0;
+    frames_ = 0;
+    emitting_ = false;
+    skipped_frames_ = 0;
+
+    for (unsigned int i = 0; i < threads; i++)
+        workers_.create_thread(boost::bind(&Jpeg_Encoder::work, this));
+}
+
+// destructor, frames which are not encoded yet are dropped
+Jpeg_Encoder::~Jpeg_Encoder()
+{
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+        running_ = false;
+        jobs_.clear();
+    }
+    condition_.notify_all();
+    emitted_.notify_all();
+    workers_.join_all();
+}
+
+// queues a raw YUV 4:2:2 image, returns false if it is skipped because the
+// workers are behind; record_latency is handed to the callback with the image
+bool Jpeg_Encoder::encode(const sensor_msgs::ImageConstPtr& raw, bool record_latency)
+{
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+        if (frames_ >= max_frames_)
+        {
+            skipped_frames_++;
+            return false;
+        }
+
+        Job job;
+        job.sequence = next_sequence_++;
+        job.raw = raw;
+        job.record_latency = record_latency;
+        jobs_.push_back(job);
+        frames_++;
+    }
+    condition_.notify_one();
+    return true;
+}
+
+// waits until all queued frames are encoded and handed to the callback
+void Jpeg_Encoder::flush()
+{
+    boost::mutex::scoped_lock lock(mutex_);
+    while (running_ && (frames_ > 0 || emitting_))
+        emitted_.wait(lock);
+}
+
+unsigned long Jpeg_Encoder::getSkippedFrames()
+{
+    boost::mutex::scoped_lock lock(mutex_);
+    return skipped_frames_;
+}
+
+// worker thread: converts and encodes one frame after the other
+void Jpeg_Encoder::work()
+{
+    // the converted image is reused for all frames of this worker
+    cv::Mat image;
+    std::vector<int> params;
+    params.push_back(CV_IMWRITE_JPEG_QUALITY);
+    params.push_back(quality_);
+
+    while (true)
+    {
+        Job job;
+        {
+            boost::mutex::scoped_lock lock(mutex_);
+            while (running_ && jobs_.empty())
+                condition_.wait(lock);
+
+            if (!running_)
+                return;
+
+            job = jobs_.front();
+            jobs_.pop_front();
+        }
+
+        // same channel order as the converted images shown on the debug screen
+        const sensor_msgs::Image& raw = *job.raw;
+        image.create(raw.height, raw.width, CV_8UC3);
+        yuvToRgb(&raw.data[0], raw.step, image.data, image.step, raw.width, raw.height);
+
+        sensor_msgs::CompressedImagePtr compressed = boost::make_shared<sensor_msgs::CompressedImage>();
+        compressed->header = raw.header;
+        compressed->format = "jpeg";
+        if (!cv::imencode(".jpg", image, compressed->data, params))
+        {
+            ROS_WARN_THROTTLE(10, "JPEG encoding of a frame failed.");
+            compressed.reset();
+        }
+
+        // a failed frame is emitted as an empty pointer, so the following frames are not held back
+        {
+            boost::mutex::scoped_lock lock(mutex_);
+            Encoded& encoded = encoded_[job.sequence];
+            encoded.compressed = compressed;
+            encoded.record_latency = job.record_latency;
+            job.raw.reset();
+        }
+        emit();
+    }
+}
+
+// publishes the encoded frames in order; only one worker emits at a time,
+// the others just leave their frames in encoded_
+void Jpeg_Encoder::emit()
+{
+    boost::mutex::scoped_lock lock(mutex_);
+    if (emitting_)
+        return;
+    emitting_ = true;
+
+    while (running_ && !encoded_.empty() && encoded_.begin()->first == next_emit_)
+    {
+        Encoded encoded = encoded_.begin()->second;
+        encoded_.erase(encoded_.begin());
+        next_emit_++;
+        frames_--;
+
+        lock.unlock();
+        if (encoded.compressed)
+            callback_(encoded.compressed, encoded.record_latency);
+        lock.lock();
+    }
+
+    emitting_ = false;
+    emitted_.notify_all();
+}
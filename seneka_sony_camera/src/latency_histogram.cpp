@@ -0,0 +1,110 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#include "latency_histogram.h"
+
+// constructor
+Latency_Histogram::Latency_Histogram(double bin_width, size_t bins)
+{
+    bin_width_ = bin_width;
+    counts_.resize(bins > 0 ? bins : 1);
+    reset();
+}
+
+// destructor
+Latency_Histogram::~Latency_Histogram()
+{
+}
+
+// adds a latency in s, negative latencies are counted in the first bin
+void Latency_Histogram::add(double latency)
+{
+    size_t bin = latency > 0 ? (size_t)(latency / bin_width_) : 0;
+    if (bin >= counts_.size())
+        bin = counts_.size() - 1;
+    counts_[bin]++;
+
+    if (samples_ == 0 || latency < min_)
+        min_ = latency;
+    if (samples_ == 0 || latency > max_)
+        max_ = latency;
+    sum_ += latency;
+    samples_++;
+}
+
+void Latency_Histogram::reset()
+{
+    counts_.assign(counts_.size(), 0);
+    samples_ = 0;
+    sum_ = 0.0;
+    min_ = 0.0;
+    max_ = 0.0;
+}
+
+// fills everything but the header of the message
+void Latency_Histogram::toMsg(seneka_msg::LatencyHistogram& msg)
+{
+    msg.bin_width = bin_width_;
+    msg.counts.assign(counts_.begin(), counts_.end());
+    msg.samples = samples_;
+    msg.min = min_;
+    msg.mean = samples_ > 0 ? sum_ / samples_ : 0.0;
+    msg.max = max_;
+}
@@ -65,26 +65,16 @@
 
 PV_INIT_SIGNAL_HANDLER();
 
-#define BUFFER_COUNT ( 1 )
-
 using namespace std;
 
-#define clip(x) (unsigned char)( (x) < 0 ? 0 : ( (x) > 255 ? 255 : (x) ) )
-
 // constructor
-Sony_Camera_Node::Sony_Camera_Node():it(nh)
+Sony_Camera_Node::Sony_Camera_Node()
 {
-    lSize = 0;
-    width_ = 0;
-    height_ = 0;
     pnh_ = ros::NodeHandle("~");
 
     // get device parameters need to control streaming
     lDeviceParams = lDevice.GetGenParameters();
 
-    // publish images
-    publish_rgb_image               =   it.advertise(       "SonyGigCam_rgb_image", 10);
-
     // advertise zooming service
     zoom_service_                   =   nh.advertiseService("set_zoomin",               &Sony_Camera_Node::zoom_in_outService, this);
 
@@ -210,13 +200,13 @@ Sony_Camera_Node::Sony_Camera_Node():it(nh)
         ROS_WARN("Using default value for initial streaming parameter [false].");
     pnh_.param("streaming",streaming_param, false);
 
-    // read parameter from parameter server
-    // if parameter not found, use default value
-    if(!pnh_.hasParam("debug_screen"))
-        ROS_WARN("Using default value for initial debug_screen parameter [false].");
-    pnh_.param("debug_screen",debug_screen_param, false);
-
+    // images are published by the pipeline, the camera is one of its frame sources
+    pipeline_ = new Image_Pipeline(nh, pnh_);
+    frame_source_ = new Ebus_Frame_Source(&lDevice, camera_ip_address_param);
 
+    // control commands of the services are executed by the worker thread of the control queue
+    publish_control_status = nh.advertise<seneka_msg::ControlStatus>("SonyGigCam_control_status", 10);
+    control_queue_ = new Control_Queue(boost::bind(&Sony_Camera_Node::controlResult, this, _1));
 
     //connect with the camera device
     connectCamera();
@@ -227,16 +217,25 @@ Sony_Camera_Node::Sony_Camera_Node():it(nh)
     //start streaming of the camera device
     if(streaming_param)
         startStreaming();
+
+    // from now on the camera is only controlled by the control queue
+    control_queue_->start();
 }
 
 //Destructor
 Sony_Camera_Node::~Sony_Camera_Node()
 {
+    //stop the control commands before the camera is stopped
+    delete control_queue_;
+
     //stop streaming of the camera device
     stopStreaming();
 
     //disconnect the camera device
     disconnectCamera();
+
+    delete pipeline_;
+    delete frame_source_;
 }
 
 //Connect camera to the device
@@ -289,7 +288,7 @@ void Sony_Camera_Node::configCamera()
 bool Sony_Camera_Node::streamingService(seneka_srv::streaming::Request &req,
                                         seneka_srv::streaming::Response &res)
 {
-    streaming(req.streaming);
+    control_queue_->pushAction("streaming", boost::bind(&Sony_Camera_Node::streaming, this, (bool) req.streaming));
 
     return true;
 }
@@ -308,166 +307,31 @@ void Sony_Camera_Node::streaming(bool decider)
     }
 }
 
-void Sony_Camera_Node::startStreaming()
+// Reports the outcome of a queued control command
+void Sony_Camera_Node::controlResult(const Control_Queue::Result& result)
 {
-    //Camera's ip address
-    PvString address = camera_ip_address_param.c_str();
-
-    //Negotiate streaming packet size
-    lDevice.NegotiatePacketSize();
-
-    //Open stream - have the PvDevice do it for us
-    ROS_INFO("3. Opening stream to device.");
-    lStream.Open( address );
-
-    //Reading payload size from device
-    lPayloadSize = dynamic_cast<PvGenInteger *>( lDeviceParams->Get( "PayloadSize" ) );
-    lPayloadSize->GetValue( lSize );
-
-    // Use min of BUFFER_COUNT and how many buffers can be queued in PvStream
-    PvUInt32 lBufferCount = ( lStream.GetQueuedBufferMaximum() < BUFFER_COUNT ) ?
-                lStream.GetQueuedBufferMaximum() :
-                BUFFER_COUNT;
-
-    // Create, alloc buffers
-    lBuffers = new PvBuffer[ lBufferCount ];
-    for ( PvUInt32 i = 0; i < lBufferCount; i++ )
-    {
-        lBuffers[ i ].Alloc( static_cast<PvUInt32>( lSize ) );
-    }
-
-    // Have to set the Device IP destination to the Stream
-    lDevice.SetStreamDestination( lStream.GetLocalIPAddress(), lStream.GetLocalPort() );
-
-    // Queue all buffers in the stream
-    for ( PvUInt32 i = 0; i < lBufferCount; i++ )
-    {
-        lStream.QueueBuffer( lBuffers + i );
-    }
-
-    ROS_INFO("Resetting timestamp counter.");
-    PvGenCommand *lResetTimestamp = dynamic_cast<PvGenCommand *>( lDeviceParams->Get( "GevTimestampControlReset" ) );
-    lResetTimestamp->Execute();
-
-    // The buffers are queued in the stream, we just have to tell the device
-    // to start sending us images
-    ROS_INFO("4. Sending StartAcquisition command to device.");
-    PvGenCommand *lStart = dynamic_cast<PvGenCommand *>( lDeviceParams->Get( "AcquisitionStart" ) );
-    lResult = lStart->Execute();
-
+    if (result.status == Control_Queue::FAILED)
+        ROS_WARN("Camera control command %s failed.", result.name.c_str());
+    else
+        ROS_DEBUG("Camera control command %s finished with status %d.", result.name.c_str(), (int) result.status);
+
+    seneka_msg::ControlStatus msg;
+    msg.header.stamp = ros::Time::now();
+    msg.command = result.name;
+    msg.status = result.status;
+    msg.queue_time = result.queue_time;
+    msg.execution_time = result.execution_time;
+    publish_control_status.publish(msg);
 }
 
-// Image publisher
-void Sony_Camera_Node::publishImage()
+void Sony_Camera_Node::startStreaming()
 {
-    PvBuffer *lBuffer = NULL;
-    PvResult lOperationResult;
-    PvImage *Image = NULL;
-
-    // Retrieve next buffer
-    lResult = lStream.RetrieveBuffer( &lBuffer, &lOperationResult, 10000 );
-    if ( lResult.IsOK() )
-    {
-        if(lOperationResult.IsOK())
-        {
-            // If the buffer contains an image, display width and height
-            if ( lBuffer->GetPayloadType() == PvPayloadTypeImage )
-            {
-                // Get image specific buffer interface
-                Image = lBuffer->GetImage();
-
-                // Read width, height
-                width_ = (int) Image->GetWidth();
-                height_ = (int) Image->GetHeight();
-            }
-
-            //Converting YUV image formate to RGB
-            int i = 0,j = 0, r1 = 0, g1 = 0, b1 = 0, r2 = 0, g2 = 0, b2 = 0;
-            IplImage* m_RGB = cvCreateImage(cvSize(width_, height_), IPL_DEPTH_8U, 3);
-            unsigned char* pData = (unsigned char *) Image->GetDataPointer();
-
-            for(i = 0, j=0; i < width_ * height_*3 ; i+=6, j+=4)
-            {
-                unsigned char u = pData[j];
-                unsigned char y1 = pData[j+1];
-                unsigned char v = pData[j+2];
-                unsigned char y2 = pData[j+3];
-
-                b1 = clip(1.0*y1 + 8 + 1.402*(v-128));
-                g1 = clip(1.0*y1 - 0.34413*(u-128) - 0.71414*(v-128));
-                r1 = clip(1.0*y1 + 1.772*(u-128));
-                b2 = clip(1.0*y2 + 8 + 1.402*(v-128));
-                g2 = clip(1.0*y2 - 0.34413*(u-128) - 0.71414*(v-128));
-                r2 = clip(1.0*y2 + 1.772*(u-128));
-
-                m_RGB->imageData[i] = r1;
-                m_RGB->imageData[i+1] = g1;
-                m_RGB->imageData[i+2] = b1;
-                m_RGB->imageData[i+3] = r2;
-                m_RGB->imageData[i+4] = g2;
-                m_RGB->imageData[i+5] = b2;
-            }
-
-            //IplImage image to cv::Mat
-            cv::Mat image(m_RGB);
-
-            if (debug_screen_param)
-                cv::namedWindow("Sony",cv::WINDOW_AUTOSIZE);
-
-            cv_bridge::CvImage out_msg;
-            out_msg.header.stamp   = ros::Time::now();
-            out_msg.encoding = sensor_msgs::image_encodings::RGB8;
-            out_msg.image    = image;
-
-            sensor_msgs::ImagePtr img = out_msg.toImageMsg();
-            img->header.frame_id = "sony_image_view";
-            publish_rgb_image.publish(img);
-
-            if (debug_screen_param)
-                cv::imshow("Current Image",image);
-
-            cv::waitKey(30);
-        }
-        else ROS_WARN("Operation unsuccessful. %s %s", lOperationResult.GetCodeString().GetAscii(), lOperationResult.GetDescription().GetAscii());
-        // re-queue the buffer in the stream object
-
-        lStream.QueueBuffer( lBuffer );
-    }
-    else
-    {
-        // Timeout
-        ROS_WARN("Timeout.");
-    }
+    pipeline_->start(frame_source_);
 }
 
 void Sony_Camera_Node::stopStreaming()
 {
-    // Clean-up
-    // Tell the device to stop sending images
-    ROS_INFO("Sending AcquisitionStop command to the device.");
-    PvGenCommand* lStop = dynamic_cast<PvGenCommand *>( lDeviceParams->Get( "AcquisitionStop" ) );
-    lStop->Execute();
-
-    // Abort all buffers from the stream, unqueue
-    ROS_INFO("Aborting buffers still in stream.");
-    lStream.AbortQueuedBuffers();
-    while ( lStream.GetQueuedBufferCount() > 0 )
-    {
-        PvBuffer *lBuffer = NULL;
-        PvResult lOperationResult;
-
-        lStream.RetrieveBuffer( &lBuffer, &lOperationResult );
-
-        ROS_INFO("Post-abort retrieved buffer: %s", lOperationResult.GetCodeString().GetAscii());
-    }
-
-    // Release buffers
-    ROS_INFO("Releasing buffers.");
-    delete []lBuffers;
-
-    // Now close the stream. Also optionnal but nice to have
-    ROS_INFO("Closing stream.");
-    lStream.Close();
+    pipeline_->stop();
 }
 
 void Sony_Camera_Node::disconnectCamera()
@@ -482,13 +346,9 @@ void Sony_Camera_Node::disconnectCamera()
 bool Sony_Camera_Node::zoom_in_outService(seneka_srv::zoom::Request &req,
                                           seneka_srv::zoom::Response &res)
 {
-    if(req.zoom_ratio_digital==1){
-        zoom_ratio_optical(req.zoom_ratio_optical);
-        res.success = true;
-    }
-
-    else if (req.zoom_ratio_optical==20 && req.zoom_ratio_digital>=2) {
-        zoom_ratio_digital(req.zoom_ratio_digital);
+    // only valid zoom ratios are queued
+    if(req.zoom_ratio_digital==1 || (req.zoom_ratio_optical==20 && req.zoom_ratio_digital>=2)){
+        control_queue_->pushAction("zoom", boost::bind(&Sony_Camera_Node::zoom_in_out, this, req.zoom_ratio_optical, req.zoom_ratio_digital));
         res.success = true;
     }
     else{
@@ -705,9 +565,8 @@ void Sony_Camera_Node::zoom_ratio_digital(int ratio)
 bool Sony_Camera_Node::focusControlService(seneka_srv::focusAuto::Request &req,
                                            seneka_srv::focusAuto::Response &res)
 {
-    autoFocusControl(req.focusAuto);
+    control_queue_->pushAction("focus_auto", boost::bind(&Sony_Camera_Node::autoFocusControl, this, req.focusAuto));
     res.success = true;
-
     return true;
 }
 
@@ -749,9 +608,8 @@ void Sony_Camera_Node::autoFocusControl(int autoFocus)
 bool Sony_Camera_Node::videoModeNextService(seneka_srv::videoMode::Request &req,
                                             seneka_srv::videoMode::Response &res)
 {
-    videoModeNext(req.video_mode_next);
+    control_queue_->pushAction("video_mode_next", boost::bind(&Sony_Camera_Node::videoModeNext, this, req.video_mode_next));
     res.success = true;
-
     return true;
 }
 
@@ -830,25 +688,31 @@ void Sony_Camera_Node::videoModeNext(int videoMode_)
 bool Sony_Camera_Node::focusPositionService(seneka_srv::focus::Request &req,
                                             seneka_srv::focus::Response &res)
 {
-    lDeviceParams->GetEnumValue("FocusAuto",focus_auto);
+    //min:4096 Max: 61440
+    if(req.focus_position >= 4096 && req.focus_position <= 61440){
+        control_queue_->push("focus_position", boost::bind(&Sony_Camera_Node::setFocusPosition, this, req.focus_position));
+        res.success = true;
+    }
+    else{
+        ROS_WARN("Focus position must be in-between 4096 and 61440.");
+        res.success = false;
+    }
+    return true;
+}
 
-    if (focus_auto == 0){
-        //min:4096 Max: 61440
-        if(req.focus_position >= 4096 && req.focus_position <= 61440){
+// queued by focusPositionService, fails while the camera's FocusAuto is not off
+bool Sony_Camera_Node::setFocusPosition(int val)
+{
+    lDeviceParams->GetEnumValue("FocusAuto",focus_auto);
 
-            lDeviceParams->SetIntegerValue("Focus",req.focus_position);
-            //lDeviceParams->ExecuteCommand("CAM_Focus");
-             lDeviceParams->ExecuteCommand("CAM_FocusPosInq");
-            res.success = true;
-        }
-        else{
-            ROS_WARN("Focus position must be in-between 4096 and 61440.");
-            res.success = false;
-        }
-    }else{
+    if (focus_auto != 0){
         ROS_WARN("Focus position cannot be change, while the camera's FocusAuto is set to continuous.");
-        res.success = false;
+        return false;
     }
+
+    lDeviceParams->SetIntegerValue("Focus",val);
+    //lDeviceParams->ExecuteCommand("CAM_Focus");
+    lDeviceParams->ExecuteCommand("CAM_FocusPosInq");
     return true;
 }
 
@@ -882,16 +746,9 @@ void Sony_Camera_Node::focusPosition(int val)
 bool Sony_Camera_Node::focusNearLimitService(seneka_srv::focusNearLimit::Request &req,
                                              seneka_srv::focusNearLimit::Response &res)
 {
-    if(focusNearLimit(req.focus_near_limit))
-    {
-        res.success = true;
-    }
-
-    else
-    {
-        res.success = false;
-    }
-
+    // the FocusAuto mode is checked when the command is executed
+    control_queue_->push("focus_near_limit", boost::bind(&Sony_Camera_Node::focusNearLimit, this, req.focus_near_limit));
+    res.success = true;
     return true;
 }
 
@@ -1004,7 +861,7 @@ bool Sony_Camera_Node::focusNearLimit(int focusLimit)
 bool  Sony_Camera_Node::infraredCutFilterAutoService(seneka_srv::infraredCutFilterAuto::Request &req,
                                                      seneka_srv::infraredCutFilterAuto::Response &res)
 {
-    infraredCutFilterAuto(req.cutfilter_auto);
+    control_queue_->pushAction("infrared_cut_filter_auto", boost::bind(&Sony_Camera_Node::infraredCutFilterAuto, this, req.cutfilter_auto));
     res.success = true;
     return true;
 }
@@ -1038,7 +895,7 @@ void Sony_Camera_Node::infraredCutFilterAuto(int val)
 bool  Sony_Camera_Node::infraredCutFilterService(seneka_srv::infraredCutFilter::Request &req,
                                                  seneka_srv::infraredCutFilter::Response &res)
 {
-    infraredCutFilter(req.cutfilter);
+    control_queue_->pushAction("infrared_cut_filter", boost::bind(&Sony_Camera_Node::infraredCutFilter, this, req.cutfilter));
     res.success = true;
     return true;
 }
@@ -1072,7 +929,7 @@ void Sony_Camera_Node::infraredCutFilter(int val)
 bool Sony_Camera_Node::pictureEffectService(seneka_srv::pictureEffect::Request &req,
                                             seneka_srv::pictureEffect::Response &res)
 {
-    pictureEffect(req.picture_effect);
+    control_queue_->pushAction("picture_effect", boost::bind(&Sony_Camera_Node::pictureEffect, this, req.picture_effect));
     res.success = true;
     return true;
 }
@@ -1110,13 +967,15 @@ void Sony_Camera_Node::pictureEffect(int val)
 bool Sony_Camera_Node::noiseReductionService(seneka_srv::noiseReduction::Request &req,
                                              seneka_srv::noiseReduction::Response &res)
 {
-    if(noiseReduction(req.noise_reduction))
+    if(0 <= req.noise_reduction && req.noise_reduction <= 5)
     {
+        control_queue_->push("noise_reduction", boost::bind(&Sony_Camera_Node::noiseReduction, this, req.noise_reduction));
         res.success = true;
     }
 
     else
     {
+        ROS_WARN("Noise Reduction should be in between 0 to 5.");
         res.success = false;
     }
     return true;
@@ -1144,7 +1003,7 @@ bool Sony_Camera_Node::noiseReduction(int val)
 bool Sony_Camera_Node::backLightCompensationService(seneka_srv::backLightCompensation::Request &req,
                                                     seneka_srv::backLightCompensation::Response &res)
 {
-    backLightCompensation(req.back_light);
+    control_queue_->pushAction("back_light_compensation", boost::bind(&Sony_Camera_Node::backLightCompensation, this, req.back_light));
     res.success = true;
     return true;
 }
@@ -1176,7 +1035,7 @@ void Sony_Camera_Node::backLightCompensation(int val)
 bool Sony_Camera_Node::statusDisplayService(seneka_srv::statusDisplay::Request &req,
                                             seneka_srv::statusDisplay::Response &res)
 {
-    statusDisplay(req.display_status);
+    control_queue_->pushAction("status_display", boost::bind(&Sony_Camera_Node::statusDisplay, this, req.display_status));
     res.success = true;
     return true;
 }
@@ -1208,7 +1067,7 @@ void Sony_Camera_Node::statusDisplay(int val)
 bool Sony_Camera_Node::titleDisplayService(seneka_srv::titleDisplay::Request &req,
                                            seneka_srv::titleDisplay::Response &res)
 {
-    titleDisplay(req.title_display);
+    control_queue_->pushAction("title_display", boost::bind(&Sony_Camera_Node::titleDisplay, this, req.title_display));
     res.success = true;
     return true;
 }
@@ -1240,7 +1099,7 @@ void Sony_Camera_Node::titleDisplay(int val)
 bool Sony_Camera_Node::titleTextService(seneka_srv::titleText::Request &req,
                                         seneka_srv::titleText::Response &res)
 {
-    titleText(req.title_text);
+    control_queue_->pushAction("title_text", boost::bind(&Sony_Camera_Node::titleText, this, req.title_text));
     res.success = true;
     return true;
 }
@@ -1259,19 +1118,11 @@ int main(int argc, char** argv)
 
     Sony_Camera_Node SonyCameraNode;
 
-    // run image_publisher periodically until node has been shut down
-    ros::Rate loop_rate(25); // Hz
-    while(SonyCameraNode.nh.ok())
-    {
-        if (SonyCameraNode.getStreamingParam())
-            SonyCameraNode.publishImage();
-
-        ros::spinOnce();
-        loop_rate.sleep();
-    }
+    // images are published by the acquisition and processing threads as soon
+    // as they arrive, service calls are handled by a separate spinner thread
+    ros::AsyncSpinner spinner(1);
+    spinner.start();
+    ros::waitForShutdown();
 
     return 0;
 }
-
-
-
@@ -0,0 +1,144 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+// Runs the image pipeline of the camera node without the camera and the
+// eBus SDK. The frames are replayed from a capture or generated, so the
+// whole publishing path can be profiled on any machine.
+
+// standard headers
+#include <string>
+
+// ros headers
+#include <ros/ros.h>
+
+// seneka_sony_camera headers
+#include "image_pipeline.h"
+#include "file_frame_source.h"
+#include "synthetic_frame_source.h"
+
+int main(int argc, char** argv)
+{
+    // initialize ROS, specify name of node
+    ros::init(argc,argv,"seneka_sony_replay");
+
+    ros::NodeHandle nh;
+    ros::NodeHandle pnh("~");
+
+    std::string source_param;
+    std::string source_file_param;
+    int source_width_param;
+    int source_height_param;
+    double source_rate_param;
+    bool source_loop_param;
+
+    // read parameter from parameter server
+    // if parameter not found, use default value
+    if(!pnh.hasParam("source"))
+        ROS_WARN("Using default value for initial source parameter [synthetic].");
+    pnh.param("source", source_param, std::string("synthetic"));
+
+    if(!pnh.hasParam("source_file") && source_param == "file")
+        ROS_WARN("Using default value for initial source_file parameter [].");
+    pnh.param("source_file", source_file_param, std::string(""));
+
+    if(!pnh.hasParam("source_width"))
+        ROS_WARN("Using default value for initial source_width parameter [1920].");
+    pnh.param("source_width", source_width_param, 1920);
+
+    if(!pnh.hasParam("source_height"))
+        ROS_WARN("Using default value for initial source_height parameter [1080].");
+    pnh.param("source_height", source_height_param, 1080);
+
+    if(!pnh.hasParam("source_rate"))
+        ROS_WARN("Using default value for initial source_rate parameter [30.0].");
+    pnh.param("source_rate", source_rate_param, 30.0);
+
+    if(!pnh.hasParam("source_loop"))
+        ROS_WARN("Using default value for initial source_loop parameter [true].");
+    pnh.param("source_loop", source_loop_param, true);
+
+    Frame_Source* source;
+    if (source_param == "file")
+        source = new File_Frame_Source(source_file_param, source_width_param, source_height_param, source_rate_param, source_loop_param);
+    else if (source_param == "synthetic")
+        source = new Synthetic_Frame_Source(source_width_param, source_height_param, source_rate_param);
+    else
+    {
+        ROS_ERROR("Unknown frame source %s, use file or synthetic.", source_param.c_str());
+        return 1;
+    }
+
+    Image_Pipeline pipeline(nh, pnh);
+    if (!pipeline.start(source))
+    {
+        delete source;
+        return 1;
+    }
+
+    // images are published by the acquisition and processing threads
+    ros::AsyncSpinner spinner(1);
+    spinner.start();
+    ros::waitForShutdown();
+
+    pipeline.stop();
+    delete source;
+
+    return 0;
+}
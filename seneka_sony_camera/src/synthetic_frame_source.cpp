@@ -0,0 +1,149 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#include "synthetic_frame_source.h"
+
+#include <algorithm>
+
+#include <ros/ros.h>
+
+// number of prepared frames, the bars move by width / SYNTHETIC_FRAMES per frame
+#define SYNTHETIC_FRAMES ( 8 )
+
+// UYVY values of the colour bars: white, yellow, cyan, green, magenta, red, blue, black
+static const unsigned char BARS[8][3] =
+{
+    {235, 128, 128}, {210,  16, 146}, {170, 166,  16}, {145,  54,  34},
+    {106, 202, 222}, { 81,  90, 240}, { 41, 240, 110}, { 16, 128, 128}
+};
+
+// constructor
+Synthetic_Frame_Source::Synthetic_Frame_Source(int width, int height, double rate)
+{
+    // UYVY needs an even width
+    width_ = width > 1 ? width & ~1 : 2;
+    height_ = height > 0 ? height : 1;
+    rate_ = rate;
+    next_ = 0;
+}
+
+// destructor
+Synthetic_Frame_Source::~Synthetic_Frame_Source()
+{
+}
+
+bool Synthetic_Frame_Source::start()
+{
+    frames_.resize(SYNTHETIC_FRAMES);
+    for (int f = 0; f < SYNTHETIC_FRAMES; f++)
+    {
+        std::vector<unsigned char>& frame = frames_[f];
+        frame.resize((size_t) width_ * height_ * 2);
+
+        // first row, shifted by the frame number
+        for (int x = 0; x < width_; x += 2)
+        {
+            int bar = ((x + f * width_ / SYNTHETIC_FRAMES) % width_) * 8 / width_;
+            unsigned char* pixel = &frame[x * 2];
+            pixel[0] = BARS[bar][1];
+            pixel[1] = BARS[bar][0];
+            pixel[2] = BARS[bar][2];
+            pixel[3] = BARS[bar][0];
+        }
+
+        // all other rows are copies of the first one
+        for (int y = 1; y < height_; y++)
+            std::copy(frame.begin(), frame.begin() + width_ * 2, frame.begin() + (size_t) y * width_ * 2);
+    }
+
+    next_ = 0;
+    next_frame_ = boost::posix_time::ptime();
+    start_time_ = boost::posix_time::microsec_clock::universal_time();
+
+    ROS_INFO("Generating %dx%d frames at %.1f Hz.", width_, height_, rate_);
+    return true;
+}
+
+void Synthetic_Frame_Source::stop()
+{
+    frames_.clear();
+}
+
+bool Synthetic_Frame_Source::retrieve(Frame& frame, unsigned int timeout)
+{
+    if (frames_.empty() || !waitForFrame(rate_, timeout))
+        return false;
+
+    frame.data = &frames_[next_][0];
+    frame.size = frames_[next_].size();
+    frame.width = width_;
+    frame.height = height_;
+    frame.step = width_ * 2;
+
+    // microseconds since the start, like a device clock which was reset
+    frame.timestamp = (boost::posix_time::microsec_clock::universal_time() - start_time_).total_microseconds();
+
+    next_ = (next_ + 1) % frames_.size();
+    return true;
+}
+
+void Synthetic_Frame_Source::release()
+{
+}
@@ -0,0 +1,346 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#include "yuv_converter.h"
+#include "yuv_converter_kernels.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define YUV_CONVERTER_NEON
+#endif
+
+#if defined(YUV_CONVERTER_AVX2)
+
+// the AVX2 kernel is compiled with -mavx2 in its own translation unit and
+// only used if the CPU supports it
+static bool useAvx2()
+{
+    if (!yuvToRgbAvx2Compiled())
+        return false;
+
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+static const bool use_avx2 = useAvx2();
+
+#endif
+
+#if defined(__SSE2__)
+
+// one step of the interleaving network: the even bytes of the 96 byte
+// sequence in the six registers become the first half, the odd bytes the
+// second half. Five steps turn 3 x 32 planar values into 32 interleaved
+// pixels. The AVX2 version (yuv_converter_avx2.cpp) works the same way on both
+// 128 bit lanes independently.
+static inline void splitEvenOdd(__m128i* v)
+{
+    const __m128i low_bytes = _mm_set1_epi16(0x00FF);
+    __m128i t0 = _mm_packus_epi16(_mm_and_si128(v[0], low_bytes), _mm_and_si128(v[1], low_bytes));
+    __m128i t1 = _mm_packus_epi16(_mm_and_si128(v[2], low_bytes), _mm_and_si128(v[3], low_bytes));
+    __m128i t2 = _mm_packus_epi16(_mm_and_si128(v[4], low_bytes), _mm_and_si128(v[5], low_bytes));
+    __m128i t3 = _mm_packus_epi16(_mm_srli_epi16(v[0], 8), _mm_srli_epi16(v[1], 8));
+    __m128i t4 = _mm_packus_epi16(_mm_srli_epi16(v[2], 8), _mm_srli_epi16(v[3], 8));
+    __m128i t5 = _mm_packus_epi16(_mm_srli_epi16(v[4], 8), _mm_srli_epi16(v[5], 8));
+    v[0] = t0; v[1] = t1; v[2] = t2; v[3] = t3; v[4] = t4; v[5] = t5;
+}
+
+// converts 8 pixels (16 bytes UYVY) into three channels with 16 bit values
+static inline void convert8(__m128i uyvy, __m128i* c0, __m128i* c1, __m128i* c2)
+{
+    const __m128i low_bytes = _mm_set1_epi16(0x00FF);
+    const __m128i offset = _mm_set1_epi16(128);
+
+    // y of every pixel, (u-128, v-128) of every pixel pair
+    __m128i y = _mm_srli_epi16(uyvy, 8);
+    __m128i uv = _mm_sub_epi16(_mm_and_si128(uyvy, low_bytes), offset);
+
+    // u and v for both pixels of a pair
+    __m128i u = _mm_shufflehi_epi16(_mm_shufflelo_epi16(uv, _MM_SHUFFLE(2,2,0,0)), _MM_SHUFFLE(2,2,0,0));
+    __m128i v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(uv, _MM_SHUFFLE(3,3,1,1)), _MM_SHUFFLE(3,3,1,1));
+
+    // (4 * x * c) >> 16 == (x * c) >> 14
+    __m128i d0 = _mm_mulhi_epi16(_mm_slli_epi16(u, 2), _mm_set1_epi16(YUV_C0_U));
+    __m128i d2 = _mm_add_epi16(_mm_mulhi_epi16(_mm_slli_epi16(v, 2), _mm_set1_epi16(YUV_C2_V)),
+                               _mm_set1_epi16(YUV_C2_OFFSET));
+
+    // the sum of both terms is computed with 32 bit before it is shifted
+    __m128i d1 = _mm_srai_epi32(_mm_madd_epi16(uv, _mm_set1_epi32(YUV_C1_PAIR)), 14);
+    d1 = _mm_packs_epi32(d1, d1);
+    d1 = _mm_unpacklo_epi16(d1, d1);
+
+    *c0 = _mm_add_epi16(y, d0);
+    *c1 = _mm_add_epi16(y, d1);
+    *c2 = _mm_add_epi16(y, d2);
+}
+
+// converts 32 pixels
+static inline void convert32(const unsigned char* src, unsigned char* dst)
+{
+    __m128i c[3][4];
+    for (int i = 0; i < 4; i++)
+        convert8(_mm_loadu_si128((const __m128i*)(src + 16 * i)), &c[0][i], &c[1][i], &c[2][i]);
+
+    __m128i v[6];
+    for (int ch = 0; ch < 3; ch++)
+    {
+        v[2 * ch] = _mm_packus_epi16(c[ch][0], c[ch][1]);
+        v[2 * ch + 1] = _mm_packus_epi16(c[ch][2], c[ch][3]);
+    }
+    for (int i = 0; i < 5; i++)
+        splitEvenOdd(v);
+    for (int i = 0; i < 6; i++)
+        _mm_storeu_si128((__m128i*)(dst + 16 * i), v[i]);
+}
+
+#endif
+
+#if defined(YUV_CONVERTER_NEON)
+
+// fixed point term (x * c) >> 14 of 8 values
+static inline int16x8_t mulShift(int16x8_t x, int16_t c)
+{
+    int32x4_t lo = vshrq_n_s32(vmull_n_s16(vget_low_s16(x), c), 14);
+    int32x4_t hi = vshrq_n_s32(vmull_n_s16(vget_high_s16(x), c), 14);
+    return vcombine_s16(vmovn_s32(lo), vmovn_s32(hi));
+}
+
+// green term (x * cu + y * cv) >> 14 of 8 values
+static inline int16x8_t mulAddShift(int16x8_t x, int16_t cu, int16x8_t y, int16_t cv)
+{
+    int32x4_t lo = vshrq_n_s32(vmlal_n_s16(vmull_n_s16(vget_low_s16(x), cu), vget_low_s16(y), cv), 14);
+    int32x4_t hi = vshrq_n_s32(vmlal_n_s16(vmull_n_s16(vget_high_s16(x), cu), vget_high_s16(y), cv), 14);
+    return vcombine_s16(vmovn_s32(lo), vmovn_s32(hi));
+}
+
+static inline uint8x8_t addClip(uint8x8_t y, int16x8_t d)
+{
+    return vqmovun_s16(vaddq_s16(vreinterpretq_s16_u16(vmovl_u8(y)), d));
+}
+
+// converts 32 pixels, vld4 separates u, y1, v and y2 of 16 pixel pairs
+static inline void convert32(const unsigned char* src, unsigned char* dst)
+{
+    uint8x16x4_t uyvy = vld4q_u8(src);
+    uint8x16_t ch[3][2];    // [channel][even/odd pixel]
+
+    for (int half = 0; half < 2; half++)
+    {
+        uint8x8_t u8 = half == 0 ? vget_low_u8(uyvy.val[0]) : vget_high_u8(uyvy.val[0]);
+        uint8x8_t y1 = half == 0 ? vget_low_u8(uyvy.val[1]) : vget_high_u8(uyvy.val[1]);
+        uint8x8_t v8 = half == 0 ? vget_low_u8(uyvy.val[2]) : vget_high_u8(uyvy.val[2]);
+        uint8x8_t y2 = half == 0 ? vget_low_u8(uyvy.val[3]) : vget_high_u8(uyvy.val[3]);
+
+        int16x8_t u = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u8)), vdupq_n_s16(128));
+        int16x8_t v = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v8)), vdupq_n_s16(128));
+
+        int16x8_t d0 = mulShift(u, YUV_C0_U);
+        int16x8_t d1 = mulAddShift(u, YUV_C1_U, v, YUV_C1_V);
+        int16x8_t d2 = vaddq_s16(mulShift(v, YUV_C2_V), vdupq_n_s16(YUV_C2_OFFSET));
+
+        uint8x8_t e0 = addClip(y1, d0), o0 = addClip(y2, d0);
+        uint8x8_t e1 = addClip(y1, d1), o1 = addClip(y2, d1);
+        uint8x8_t e2 = addClip(y1, d2), o2 = addClip(y2, d2);
+
+        if (half == 0)
+        {
+            ch[0][0] = vcombine_u8(e0, e0); ch[0][1] = vcombine_u8(o0, o0);
+            ch[1][0] = vcombine_u8(e1, e1); ch[1][1] = vcombine_u8(o1, o1);
+            ch[2][0] = vcombine_u8(e2, e2); ch[2][1] = vcombine_u8(o2, o2);
+        }
+        else
+        {
+            ch[0][0] = vcombine_u8(vget_low_u8(ch[0][0]), e0); ch[0][1] = vcombine_u8(vget_low_u8(ch[0][1]), o0);
+            ch[1][0] = vcombine_u8(vget_low_u8(ch[1][0]), e1); ch[1][1] = vcombine_u8(vget_low_u8(ch[1][1]), o1);
+            ch[2][0] = vcombine_u8(vget_low_u8(ch[2][0]), e2); ch[2][1] = vcombine_u8(vget_low_u8(ch[2][1]), o2);
+        }
+    }
+
+    // even and odd pixels back in order, vst3 interleaves the channels
+    uint8x16x2_t z0 = vzipq_u8(ch[0][0], ch[0][1]);
+    uint8x16x2_t z1 = vzipq_u8(ch[1][0], ch[1][1]);
+    uint8x16x2_t z2 = vzipq_u8(ch[2][0], ch[2][1]);
+
+    uint8x16x3_t out;
+    out.val[0] = z0.val[0]; out.val[1] = z1.val[0]; out.val[2] = z2.val[0];
+    vst3q_u8(dst, out);
+    out.val[0] = z0.val[1]; out.val[1] = z1.val[1]; out.val[2] = z2.val[1];
+    vst3q_u8(dst + 48, out);
+}
+
+#endif
+
+// converts one row
+static void convertRow(const unsigned char* src, unsigned char* dst, int width)
+{
+    int x = 0;
+
+#if defined(YUV_CONVERTER_AVX2)
+    if (use_avx2)
+        x = yuvToRgbAvx2(src, dst, width);
+#endif
+#if defined(__SSE2__) || defined(YUV_CONVERTER_NEON)
+    for (; x + 32 <= width; x += 32)
+        convert32(src + 2 * x, dst + 3 * x);
+#endif
+
+    // remaining pixel pairs, same arithmetic as the SIMD implementations
+    for (; x + 1 < width; x += 2)
+    {
+        const unsigned char* p = src + 2 * x;
+        unsigned char* q = dst + 3 * x;
+
+        int u = p[0] - 128;
+        int v = p[2] - 128;
+        int d0 = (YUV_C0_U * u) >> 14;
+        int d1 = (YUV_C1_U * u + YUV_C1_V * v) >> 14;
+        int d2 = ((YUV_C2_V * v) >> 14) + YUV_C2_OFFSET;
+
+        q[0] = clip(p[1] + d0);
+        q[1] = clip(p[1] + d1);
+        q[2] = clip(p[1] + d2);
+        q[3] = clip(p[3] + d0);
+        q[4] = clip(p[3] + d1);
+        q[5] = clip(p[3] + d2);
+    }
+}
+
+void yuvToRgb(const unsigned char* src, int src_step,
+              unsigned char* dst, int dst_step,
+              int width, int height)
+{
+    for (int row = 0; row < height; row++)
+        convertRow(src + row * src_step, dst + row * dst_step, width);
+}
+
+void yuvToRgbDownscaled(const unsigned char* src, int src_step,
+                        unsigned char* dst, int dst_step,
+                        int width, int height, int scale)
+{
+    int columns = width / scale;
+
+    for (int row = 0; row < height; row++)
+    {
+        const unsigned char* p = src + (size_t) row * scale * src_step;
+        unsigned char* q = dst + row * dst_step;
+
+        for (int i = 0; i < columns; i++, q += 3)
+        {
+            // pixel pair in the middle of the block, at an even column
+            int j = ((i * scale + scale / 2) & ~1) * 2;
+
+            int y = (p[j+1] + p[j+3] + 1) >> 1;
+            int u = p[j] - 128;
+            int v = p[j+2] - 128;
+
+            int c0 = y + ((YUV_C0_U * u) >> 14);
+            int c1 = y + ((YUV_C1_U * u + YUV_C1_V * v) >> 14);
+            int c2 = y + ((YUV_C2_V * v) >> 14) + YUV_C2_OFFSET;
+
+            q[0] = clip(c0);
+            q[1] = clip(c1);
+            q[2] = clip(c2);
+        }
+    }
+}
+
+void yuvToRgbReference(const unsigned char* src, int src_step,
+                       unsigned char* dst, int dst_step,
+                       int width, int height)
+{
+    for (int row = 0; row < height; row++)
+    {
+        const unsigned char* p = src + row * src_step;
+        unsigned char* q = dst + row * dst_step;
+
+        for (int i = 0, j = 0; i < width * 3; i += 6, j += 4)
+        {
+            unsigned char u = p[j];
+            unsigned char y1 = p[j+1];
+            unsigned char v = p[j+2];
+            unsigned char y2 = p[j+3];
+
+            q[i]   = clip(1.0*y1 + 1.772*(u-128));
+            q[i+1] = clip(1.0*y1 - 0.34413*(u-128) - 0.71414*(v-128));
+            q[i+2] = clip(1.0*y1 + 8 + 1.402*(v-128));
+            q[i+3] = clip(1.0*y2 + 1.772*(u-128));
+            q[i+4] = clip(1.0*y2 - 0.34413*(u-128) - 0.71414*(v-128));
+            q[i+5] = clip(1.0*y2 + 8 + 1.402*(v-128));
+        }
+    }
+}
+
+const char* yuvToRgbImplementation()
+{
+#if defined(YUV_CONVERTER_AVX2)
+    if (use_avx2)
+        return "avx2";
+#endif
+#if defined(__SSE2__)
+    return "sse2";
+#elif defined(YUV_CONVERTER_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
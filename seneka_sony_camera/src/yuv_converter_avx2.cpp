@@ -0,0 +1,166 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+#include "yuv_converter_kernels.h"
+
+// AVX2 versions of the SSE2 functions in yuv_converter.cpp, compiled with
+// -mavx2; without it only stubs are built and the kernel is never selected
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+// AVX2 version of splitEvenOdd, see yuv_converter.cpp
+static inline void splitEvenOdd(__m256i* v)
+{
+    const __m256i low_bytes = _mm256_set1_epi16(0x00FF);
+    __m256i t0 = _mm256_packus_epi16(_mm256_and_si256(v[0], low_bytes), _mm256_and_si256(v[1], low_bytes));
+    __m256i t1 = _mm256_packus_epi16(_mm256_and_si256(v[2], low_bytes), _mm256_and_si256(v[3], low_bytes));
+    __m256i t2 = _mm256_packus_epi16(_mm256_and_si256(v[4], low_bytes), _mm256_and_si256(v[5], low_bytes));
+    __m256i t3 = _mm256_packus_epi16(_mm256_srli_epi16(v[0], 8), _mm256_srli_epi16(v[1], 8));
+    __m256i t4 = _mm256_packus_epi16(_mm256_srli_epi16(v[2], 8), _mm256_srli_epi16(v[3], 8));
+    __m256i t5 = _mm256_packus_epi16(_mm256_srli_epi16(v[4], 8), _mm256_srli_epi16(v[5], 8));
+    v[0] = t0; v[1] = t1; v[2] = t2; v[3] = t3; v[4] = t4; v[5] = t5;
+}
+
+// AVX2 version of convert8 (8 pixels per 128 bit lane)
+static inline void convert16(__m256i uyvy, __m256i* c0, __m256i* c1, __m256i* c2)
+{
+    const __m256i low_bytes = _mm256_set1_epi16(0x00FF);
+    const __m256i offset = _mm256_set1_epi16(128);
+
+    __m256i y = _mm256_srli_epi16(uyvy, 8);
+    __m256i uv = _mm256_sub_epi16(_mm256_and_si256(uyvy, low_bytes), offset);
+
+    __m256i u = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(uv, _MM_SHUFFLE(2,2,0,0)), _MM_SHUFFLE(2,2,0,0));
+    __m256i v = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(uv, _MM_SHUFFLE(3,3,1,1)), _MM_SHUFFLE(3,3,1,1));
+
+    __m256i d0 = _mm256_mulhi_epi16(_mm256_slli_epi16(u, 2), _mm256_set1_epi16(YUV_C0_U));
+    __m256i d2 = _mm256_add_epi16(_mm256_mulhi_epi16(_mm256_slli_epi16(v, 2), _mm256_set1_epi16(YUV_C2_V)),
+                                  _mm256_set1_epi16(YUV_C2_OFFSET));
+
+    __m256i d1 = _mm256_srai_epi32(_mm256_madd_epi16(uv, _mm256_set1_epi32(YUV_C1_PAIR)), 14);
+    d1 = _mm256_packs_epi32(d1, d1);
+    d1 = _mm256_unpacklo_epi16(d1, d1);
+
+    *c0 = _mm256_add_epi16(y, d0);
+    *c1 = _mm256_add_epi16(y, d1);
+    *c2 = _mm256_add_epi16(y, d2);
+}
+
+// converts 64 pixels: the lower 128 bit lanes hold pixels 0..31, the upper
+// lanes pixels 32..63, so all in-lane operations work like the SSE2 version
+static inline void convert64(const unsigned char* src, unsigned char* dst)
+{
+    __m256i r0 = _mm256_loadu_si256((const __m256i*)(src));
+    __m256i r1 = _mm256_loadu_si256((const __m256i*)(src + 32));
+    __m256i r2 = _mm256_loadu_si256((const __m256i*)(src + 64));
+    __m256i r3 = _mm256_loadu_si256((const __m256i*)(src + 96));
+
+    __m256i in[4];
+    in[0] = _mm256_permute2x128_si256(r0, r2, 0x20);
+    in[1] = _mm256_permute2x128_si256(r0, r2, 0x31);
+    in[2] = _mm256_permute2x128_si256(r1, r3, 0x20);
+    in[3] = _mm256_permute2x128_si256(r1, r3, 0x31);
+
+    __m256i c[3][4];
+    for (int i = 0; i < 4; i++)
+        convert16(in[i], &c[0][i], &c[1][i], &c[2][i]);
+
+    __m256i v[6];
+    for (int ch = 0; ch < 3; ch++)
+    {
+        v[2 * ch] = _mm256_packus_epi16(c[ch][0], c[ch][1]);
+        v[2 * ch + 1] = _mm256_packus_epi16(c[ch][2], c[ch][3]);
+    }
+    for (int i = 0; i < 5; i++)
+        splitEvenOdd(v);
+    for (int i = 0; i < 6; i++)
+    {
+        _mm_storeu_si128((__m128i*)(dst + 16 * i), _mm256_castsi256_si128(v[i]));
+        _mm_storeu_si128((__m128i*)(dst + 96 + 16 * i), _mm256_extracti128_si256(v[i], 1));
+    }
+}
+
+int yuvToRgbAvx2(const unsigned char* src, unsigned char* dst, int width)
+{
+    int x = 0;
+    for (; x + 64 <= width; x += 64)
+        convert64(src + 2 * x, dst + 3 * x);
+    return x;
+}
+
+bool yuvToRgbAvx2Compiled()
+{
+    return true;
+}
+
+#elif defined(YUV_CONVERTER_AVX2)
+
+int yuvToRgbAvx2(const unsigned char*, unsigned char*, int)
+{
+    return 0;
+}
+
+bool yuvToRgbAvx2Compiled()
+{
+    return false;
+}
+
+#endif
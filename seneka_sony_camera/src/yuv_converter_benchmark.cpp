@@ -0,0 +1,143 @@
+/****************************************************************
+*
+* Copyright (c) 2014
+*
+* Fraunhofer Institute for Manufacturing Engineering and Automation (IPA)
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Project name: SeNeKa
+* ROS metapackage: seneka_sensor_node
+* ROS package: seneka_sony_camera
+* GitHub repository: https://github.com/ipa320/seneka_sensor_node
+* 
+* Package description: The seneka_sony_camera package is part of the
+* seneka_sensor_node metapackage, developed for the SeNeKa project at
+* Fraunhofer IPA. It implements a ROS driver for the Sony Block Camera
+* FCB EH 6300. This package might work with other hardware and can be used
+* for other purposes, however the development has been specifically for this
+* project and the deployed sensors.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Supervisor: Matthias Gruhler, E-Mail: Matthias.Gruhler@ipa.fraunhofer.de
+* Author: Rajib Banik
+*
+* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Date of creation: 19.10.2026
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright
+* notice, this list of conditions and the following disclaimer.
+* Redistributions in binary form must reproduce the above copyright
+* notice, this list of conditions and the following disclaimer in the
+* documentation and/or other materials provided with the distribution.
+* Neither the name of the Fraunhofer Institute for Manufacturing
+* Engineering and Automation (IPA) nor the names of its
+* contributors may be used to endorse or promote products derived from
+* this software without specific prior written permission.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License LGPL as
+* published by the Free Software Foundation, either version 3 of the
+* License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License LGPL along with this program.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+****************************************************************/
+
+// Micro-benchmark of the YUV 4:2:2 (UYVY) to RGB conversion: compares the
+// original double precision loop, the fixed point conversion of
+// yuv_converter.cpp and cv::cvtColor on a random full HD image.
+//
+// usage: yuv_converter_benchmark [width height iterations]
+
+#include "yuv_converter.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+// milliseconds per frame of the last measurement
+static double elapsed(int64 start, int iterations)
+{
+    return (cv::getTickCount() - start) * 1000.0 / cv::getTickFrequency() / iterations;
+}
+
+// maximal and number of differing channel values
+static void compare(const cv::Mat& a, const cv::Mat& b, int* max_diff, double* differing)
+{
+    cv::Mat diff;
+    cv::absdiff(a, b, diff);
+    double max_val;
+    cv::minMaxLoc(diff.reshape(1), NULL, &max_val);
+    *max_diff = (int)max_val;
+    *differing = 100.0 * cv::countNonZero(diff.reshape(1)) / (a.total() * a.channels());
+}
+
+int main(int argc, char** argv)
+{
+    int width = 1920, height = 1080, iterations = 100;
+    if (argc == 4)
+    {
+        width = atoi(argv[1]);
+        height = atoi(argv[2]);
+        iterations = atoi(argv[3]);
+    }
+    if (width <= 0 || width % 2 != 0 || height <= 0 || iterations <= 0)
+    {
+        printf("usage: %s [width height iterations], width has to be even\n", argv[0]);
+        return 1;
+    }
+
+    // random camera image
+    cv::Mat uyvy(height, width, CV_8UC2);
+    cv::randu(uyvy, cv::Scalar::all(0), cv::Scalar::all(256));
+
+    cv::Mat reference(height, width, CV_8UC3);
+    cv::Mat converted(height, width, CV_8UC3);
+    cv::Mat opencv(height, width, CV_8UC3);
+
+    printf("%dx%d, %d iterations, implementation: %s\n", width, height, iterations, yuvToRgbImplementation());
+
+    int64 start = cv::getTickCount();
+    for (int i = 0; i < iterations; i++)
+        yuvToRgbReference(uyvy.data, uyvy.step, reference.data, reference.step, width, height);
+    double reference_ms = elapsed(start, iterations);
+
+    start = cv::getTickCount();
+    for (int i = 0; i < iterations; i++)
+        yuvToRgb(uyvy.data, uyvy.step, converted.data, converted.step, width, height);
+    double converted_ms = elapsed(start, iterations);
+
+    start = cv::getTickCount();
+    for (int i = 0; i < iterations; i++)
+        cv::cvtColor(uyvy, opencv, CV_YUV2RGB_UYVY);
+    double opencv_ms = elapsed(start, iterations);
+
+    int max_diff;
+    double differing;
+    compare(reference, converted, &max_diff, &differing);
+
+    printf("original loop:   %8.3f ms/frame\n", reference_ms);
+    printf("yuvToRgb:        %8.3f ms/frame (x%.1f), max. difference %d, %.3f%% of the values differ\n",
+           converted_ms, reference_ms / converted_ms, max_diff, differing);
+    printf("cv::cvtColor:    %8.3f ms/frame (x%.1f), BT.601 video range, not comparable to the original formula\n",
+           opencv_ms, reference_ms / opencv_ms);
+
+    return max_diff <= 1 ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ *   Copyright (c) 2012 \n
+ *   Fraunhofer Institute for Manufacturing Engineering
+ *   and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ *   Project name: SENEKA
+ * \note
+ *   ROS stack name: SENEKA
+ * \note
+ *   ROS package name: seneka_termo_video_manager
+ *
+ * \author
+ *   Author: Johannes Goth (cmm-jg)
+ * \author
+ *   Supervised by: Christophe Maufroy (cmm)
+ *
+ * \date Date of creation: 19.10.2026
+ *
+ * \brief
+ *   containerIndex.cpp
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     - Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer. \n
+ *     - Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution. \n
+ *     - Neither the name of the Fraunhofer Institute for Manufacturing
+ *       Engineering and Automation (IPA) nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#include "containerIndex.h"
+
+// identifies a valid frame offset table at the end of a container file ("SNKI")
+#define CONTAINER_INDEX_MAGIC 0x494B4E53
+
+ContainerIndex::ContainerIndex(){}
+
+ContainerIndex::~ContainerIndex(){}
+
+void ContainerIndex::clear(){
+	entries.clear();
+}
+
+void ContainerIndex::addFrame(u_int64_t offset, ros::Time stamp){
+	Entry entry;
+	entry.offset = offset;
+	entry.sec = stamp.sec;
+	entry.nsec = stamp.nsec;
+	entries.push_back(entry);
+}
+
+u_int64_t ContainerIndex::getOffset(u_int frame){
+	return entries.at(frame).offset;
+}
+
+ros::Time ContainerIndex::getStamp(u_int frame){
+	return ros::Time(entries.at(frame).sec, entries.at(frame).nsec);
+}
+
+// returns the first frame which was captured at or after the given time stamp, or -1 if there is none
+int ContainerIndex::findFrame(ros::Time stamp){
+	for(u_int i=0; i < entries.size(); i++){
+		if(getStamp(i) >= stamp)
+			return i;
+	}
+	return -1;
+}
+
+// appends the offset table and the footer at the current position of the output file
+bool ContainerIndex::write(std::ofstream& ofs){
+	Footer footer;
+	footer.tableOffset = ofs.tellp();
+	footer.frameCount = entries.size();
+	footer.magic = CONTAINER_INDEX_MAGIC;
+
+	if(!entries.empty())
+		ofs.write((const char*)&entries[0], entries.size() * sizeof(Entry));
+	ofs.write((const char*)&footer, sizeof(Footer));
+
+	return ofs.good();
+}
+
+// reads the offset table from the end of the input file
+bool ContainerIndex::read(std::ifstream& ifs){
+	entries.clear();
+
+	ifs.seekg(0, std::ios::end);
+	u_int64_t fileSize = ifs.tellg();
+	if(!ifs.good() || fileSize < sizeof(Footer))
+		return false;
+
+	Footer footer;
+	ifs.seekg(fileSize - sizeof(Footer));
+	ifs.read((char*)&footer, sizeof(Footer));
+
+	// verify that the footer belongs to a complete table
+	if(!ifs.good() || footer.magic != CONTAINER_INDEX_MAGIC ||
+			footer.tableOffset + footer.frameCount * sizeof(Entry) + sizeof(Footer) != fileSize)
+		return false;
+
+	entries.resize(footer.frameCount);
+	ifs.seekg(footer.tableOffset);
+	if(!entries.empty())
+		ifs.read((char*)&entries[0], entries.size() * sizeof(Entry));
+
+	if(!ifs.good()){
+		entries.clear();
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,107 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ *   Copyright (c) 2012 \n
+ *   Fraunhofer Institute for Manufacturing Engineering
+ *   and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ *   Project name: SENEKA
+ * \note
+ *   ROS stack name: SENEKA
+ * \note
+ *   ROS package name: seneka_termo_video_manager
+ *
+ * \author
+ *   Author: Johannes Goth (cmm-jg)
+ * \author
+ *   Supervised by: Christophe Maufroy (cmm)
+ *
+ * \date Date of creation: 19.10.2026
+ *
+ * \brief
+ *   containerIndex.h
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     - Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer. \n
+ *     - Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution. \n
+ *     - Neither the name of the Fraunhofer Institute for Manufacturing
+ *       Engineering and Automation (IPA) nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#ifndef CONTAINERINDEX_H_
+#define CONTAINERINDEX_H_
+
+// libraries
+#include <fstream>
+#include <vector>
+// ROS includes
+#include "ros/ros.h"
+
+/* Frame offset table of a binary container file
+ * Each container file ends with a table, which stores the byte offset and the time stamp of every frame inside the
+ * file, followed by a fixed size footer. So a reader is able to seek directly to frame k without deserializing all
+ * frames before it (e.g. for thumbnails or to start a video in the middle of a container file). */
+class ContainerIndex {
+public:
+
+	// public member functions
+	ContainerIndex();
+	virtual ~ContainerIndex();
+	void clear();
+	void addFrame(u_int64_t offset, ros::Time stamp);
+	u_int size(){return entries.size();};
+	u_int64_t getOffset(u_int frame);
+	ros::Time getStamp(u_int frame);
+	int findFrame(ros::Time stamp);
+	bool write(std::ofstream& ofs);
+	bool read(std::ifstream& ifs);
+
+private:
+
+	// one table entry per frame
+	struct Entry {
+		u_int64_t offset;	// byte offset of the serialized frame inside the container file
+		u_int32_t sec;		// time stamp of the frame
+		u_int32_t nsec;
+	};
+
+	// footer at the end of the container file
+	struct Footer {
+		u_int64_t tableOffset;	// byte offset of the first table entry
+		u_int32_t frameCount;
+		u_int32_t magic;
+	};
+
+	std::vector<Entry> entries;
+};
+
+#endif /* CONTAINERINDEX_H_ */
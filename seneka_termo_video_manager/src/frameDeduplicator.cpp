@@ -0,0 +1,144 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ *   Copyright (c) 2012 \n
+ *   Fraunhofer Institute for Manufacturing Engineering
+ *   and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ *   Project name: SENEKA
+ * \note
+ *   ROS stack name: SENEKA
+ * \note
+ *   ROS package name: seneka_termo_video_manager
+ *
+ * \author
+ *   Author: Johannes Goth (cmm-jg)
+ * \author
+ *   Supervised by: Christophe Maufroy (cmm)
+ *
+ * \date Date of creation: 19.10.2026
+ *
+ * \brief
+ *   frameDeduplicator.cpp
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     - Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer. \n
+ *     - Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution. \n
+ *     - Neither the name of the Fraunhofer Institute for Manufacturing
+ *       Engineering and Automation (IPA) nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#include "frameDeduplicator.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+FrameDeduplicator::FrameDeduplicator(){
+	threshold = 0;
+	hasReference = false;
+}
+
+FrameDeduplicator::~FrameDeduplicator(){}
+
+// threshold <= 0 disables the deduplication
+void FrameDeduplicator::setThreshold(double threshold){
+	this->threshold = threshold;
+}
+
+// forgets the reference frame, so the next frame is stored in full
+void FrameDeduplicator::reset(){
+	hasReference = false;
+	reference = sensor_msgs::Image();
+}
+
+// returns true if the frame does not differ from the reference frame, otherwise it becomes the new reference frame
+bool FrameDeduplicator::isDuplicate(const sensor_msgs::Image& frame){
+
+	if(!isEnabled())
+		return false;
+
+	if(hasReference && frame.width == reference.width && frame.height == reference.height &&
+			frame.step == reference.step && frame.encoding == reference.encoding &&
+			frame.data.size() == reference.data.size() && !frame.data.empty()){
+
+		u_int64_t limit = (u_int64_t)(threshold * frame.width * frame.height);
+		if(!exceeds(frame, limit))
+			return true;
+	}
+
+	reference = frame;
+	hasReference = true;
+	return false;
+}
+
+// compares the frame row by row with the reference frame, until the sum of absolute differences exceeds limit
+bool FrameDeduplicator::exceeds(const sensor_msgs::Image& frame, u_int64_t limit){
+
+	u_int64_t sum = 0;
+	for(u_int row=0; row < frame.height; row++){
+		const u_int16_t* a = (const u_int16_t*)&frame.data[row * frame.step];
+		const u_int16_t* b = (const u_int16_t*)&reference.data[row * reference.step];
+
+		sum += sumAbsDiff(a, b, frame.width);
+		if(sum > limit)
+			return true;
+	}
+	return false;
+}
+
+// sum of absolute differences of two rows with 16 bit values
+u_int64_t FrameDeduplicator::sumAbsDiff(const u_int16_t* a, const u_int16_t* b, int length){
+
+	u_int64_t sum = 0;
+	int i = 0;
+
+#ifdef __SSE2__
+	// the 32 bit lanes can not overflow for rows shorter than 4 * 65536 values
+	const __m128i zero = _mm_setzero_si128();
+	__m128i acc = _mm_setzero_si128();
+	for(; i + 8 <= length; i += 8){
+		__m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+		__m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+		__m128i diff = _mm_or_si128(_mm_subs_epu16(va, vb), _mm_subs_epu16(vb, va));
+		acc = _mm_add_epi32(acc, _mm_add_epi32(_mm_unpacklo_epi16(diff, zero), _mm_unpackhi_epi16(diff, zero)));
+	}
+	u_int32_t lanes[4];
+	_mm_storeu_si128((__m128i*)lanes, acc);
+	sum = (u_int64_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+	for(; i < length; i++)
+		sum += a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+
+	return sum;
+}
@@ -0,0 +1,94 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ *   Copyright (c) 2012 \n
+ *   Fraunhofer Institute for Manufacturing Engineering
+ *   and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ *   Project name: SENEKA
+ * \note
+ *   ROS stack name: SENEKA
+ * \note
+ *   ROS package name: seneka_termo_video_manager
+ *
+ * \author
+ *   Author: Johannes Goth (cmm-jg)
+ * \author
+ *   Supervised by: Christophe Maufroy (cmm)
+ *
+ * \date Date of creation: 19.10.2026
+ *
+ * \brief
+ *   frameDeduplicator.h
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     - Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer. \n
+ *     - Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution. \n
+ *     - Neither the name of the Fraunhofer Institute for Manufacturing
+ *       Engineering and Automation (IPA) nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#ifndef FRAMEDEDUPLICATOR_H_
+#define FRAMEDEDUPLICATOR_H_
+
+// ROS includes
+#include "ros/ros.h"
+#include "sensor_msgs/Image.h"
+
+/* Detection of frames of a static scene
+ * Each new temperature frame is compared with the last stored (reference) frame. If the mean absolute difference of
+ * the raw 16 bit values is not above the threshold, the frame is a duplicate and only its time stamp has to be stored.
+ * Otherwise it becomes the new reference frame. The comparison uses SSE2 if it is available and stops as soon as the
+ * threshold is exceeded. */
+class FrameDeduplicator {
+public:
+
+	// public member functions
+	FrameDeduplicator();
+	virtual ~FrameDeduplicator();
+	void setThreshold(double threshold);
+	bool isEnabled(){return threshold > 0;};
+	bool isDuplicate(const sensor_msgs::Image& frame);
+	void reset();
+
+private:
+
+	// private member functions
+	bool exceeds(const sensor_msgs::Image& frame, u_int64_t limit);
+	static u_int64_t sumAbsDiff(const u_int16_t* a, const u_int16_t* b, int length);
+
+	double threshold;			// mean absolute difference in raw temperature values
+	bool hasReference;
+	sensor_msgs::Image reference;
+};
+
+#endif /* FRAMEDEDUPLICATOR_H_ */
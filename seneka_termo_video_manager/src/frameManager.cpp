@@ -112,6 +112,7 @@ FrameManager::FrameManager() {
 	iBuilder.setPalette(optris::eIron);
 	iBuilder.setManualTemperatureRange((float)20, (float)40);
 	showFrame = false;
+	preview = new FramePreview("Display window", 10);
 	snapshotRunning = false;
 	liveStreamRunning = false;
 	stateMachine = ON_DEMAND;
@@ -134,6 +135,7 @@ FrameManager::FrameManager(ros::NodeHandle &pnHandle) {
 
 	// initialize configurable parameters
 	int tmp_fpv, tmp_fpc, tmp_fpb, tmp_vfr, tmp_PaletteScalingMethod, tmp_Palette, minTemperature, maxTemperature;
+	double dedupThreshold;
 
 	pnHandle.getParam("framesPerVideo", tmp_fpv);
 	pnHandle.getParam("framesPerCache", tmp_fpc);
@@ -188,6 +190,19 @@ FrameManager::FrameManager(ros::NodeHandle &pnHandle) {
 	else
 		pnHandle.getParam("showFrame", showFrame);
 
+	double previewRate;
+	if(!pnHandle.hasParam("previewRate")){
+		ROS_WARN("Used default parameter for previewRate [10]");
+		previewRate = 10;
+	}
+	else
+		pnHandle.getParam("previewRate", previewRate);
+
+	// frames are shown in a separate thread, so the GUI never slows down caching or video creation
+	preview = new FramePreview("Display window", previewRate);
+	if(showFrame)
+		preview->start();
+
 	if(!pnHandle.hasParam("minTemperature")){
 		ROS_WARN("Used default parameter for minTemperature [20]");
 		minTemperature = 20;
@@ -220,6 +235,15 @@ FrameManager::FrameManager(ros::NodeHandle &pnHandle) {
 	iBuilder.setPalette((optris::EnumOptrisColoringPalette)tmp_Palette);
 	iBuilder.setManualTemperatureRange((float)minTemperature, (float)maxTemperature);
 
+	if(!pnHandle.hasParam("dedupThreshold")){
+		ROS_WARN("Used default parameter for dedupThreshold [0]");
+		dedupThreshold = 0;
+	}
+	else
+		pnHandle.getParam("dedupThreshold", dedupThreshold);
+
+	deduplicator.setThreshold(dedupThreshold);
+
 	// initialize fixed parameters
 	videoCodec = CV_FOURCC('D','I','V','X');
 	binaryFileIndex = 0;
@@ -250,6 +274,7 @@ FrameManager::FrameManager(ros::NodeHandle &pnHandle) {
 }
 
 FrameManager::~FrameManager() {
+	delete preview;
 	delete cacheA;
 	delete cacheB;
 }
@@ -265,6 +290,15 @@ void FrameManager::cacheFrame(sensor_msgs::Image frame){
 
 	if(stateMachine == ON_DEMAND){
 		std::vector<sensor_msgs::Image>* currentCache = getCurrentCache();
+
+		// each binary file starts with a full frame, so it never references frames of another binary file
+		if(currentCache->empty())
+			deduplicator.reset();
+
+		if(deduplicator.isDuplicate(frame)){
+			// only the time stamp is cached, the frame is stored as reference to the last full frame
+			frame.data.clear();
+		}
 		currentCache->push_back(frame);
 	}
 	else if(stateMachine == LIVE_STREAM){
@@ -387,13 +421,36 @@ void FrameManager::storeCache(std::vector<sensor_msgs::Image>* cache, bool* thre
 		//		      out.push(io::zlib_compressor(io::zlib::best_speed));
 		//		      out.push(ofs);
 
-		boost::archive::binary_oarchive oa(ofs);
+		ContainerIndex index;
+		u_int64_t referenceOffset = 0;
+		u_int storedFrames = 0;
 
 		// writes each frame which is stored in cache into binary file
 		for (std::vector<sensor_msgs::Image>::iterator it = cache->begin() ; it != cache->end(); it++){
+			if(it->data.empty()){
+				// duplicate frame -> table entry points to the last full frame
+				if(storedFrames > 0)
+					index.addFrame(referenceOffset, it->header.stamp);
+				continue;
+			}
+
+			// remember where the frame starts, so it can be read without reading the frames before it
+			referenceOffset = ofs.tellp();
+			index.addFrame(referenceOffset, it->header.stamp);
+			storedFrames++;
+
 			// writes frame per frame into binary file, using sensor_msgs::Image serialization
+			// every frame gets its own archive without header, so it can be deserialized on its own
+			boost::archive::binary_oarchive oa(ofs, boost::archive::no_header);
 			oa << *it;
 		}
+
+		// append frame offset table
+		if(!index.write(ofs))
+			ROS_ERROR("Could not write frame offset table into %s", fileName.str().c_str());
+
+		if(deduplicator.isEnabled())
+			ROS_INFO("Stored %d of %d frames, the others are duplicates", storedFrames, (int)cache->size());
 	}
 	// close file
 	ofs.close();
@@ -484,46 +541,37 @@ int FrameManager::createVideo(){
 		// open inputFile
 		std::ifstream ifs(inputFileName.str().c_str(), std::ios::in | std::ios::binary);
 
-		// scope is required to ensure archive and filtering stream buffer go out of scope
-		// before stream
-		{
-			//			// decompressing frame size
-			//			io::filtering_streambuf<io::input> in;
-			//			in.push(io::zlib_decompressor());
-			//			in.push(ifs);
-
-			boost::archive::binary_iarchive ia(ifs);
+		// read frame offset table of the binary file
+		ContainerIndex index;
+		if(!index.read(ifs)){
+			ROS_WARN("No frame offset table in %s, reading the frames sequentially", inputFileName.str().c_str());
+			readFramesSequentially(ifs, vRecoder, &firstFrame, &frameCount);
+		}
 
-			bool hasContent = true;
-			while (hasContent)
-			{
+		cv::Mat mat;
+		for(u_int frame=0; frame < index.size(); frame++){
+			// duplicate frames refer to the offset of the previous frame, which is already converted
+			if(frame == 0 || index.getOffset(frame) != index.getOffset(frame-1)){
 				sensor_msgs::Image loadedFrame;
-				if(firstFrame){
-					// try to read a temperature image from binary file
-					hasContent = boost::serialization::try_stream_next(ia, ifs, loadedFrame);
-					if (hasContent == true){
-						// convert temperature image (sensor_msgs::Image) to RGB image (cv::Mat)
-						cv::Mat mat = convertTemperatureValuesToRGB(&loadedFrame, &frameCount);
-						// define video parameters
-						vRecoder->createVideo(videoFilePath, mat.cols, mat.rows);
-						// add frame to video
-						vRecoder->addFrame(mat);
-						firstFrame = false;
-					}
 
-				}
-				else{
-					// try to read a temperature image from binary file
-					hasContent = boost::serialization::try_stream_next(ia, ifs, loadedFrame);
-					// convert and add frame to video
-					if (hasContent == true)
-						vRecoder->addFrame(convertTemperatureValuesToRGB(&loadedFrame, &frameCount));
-				}
+				// try to read a temperature image from binary file
+				if(!readFrame(ifs, index, frame, loadedFrame))
+					break;
+
+				// convert temperature image (sensor_msgs::Image) to RGB image (cv::Mat)
+				mat = convertTemperatureValuesToRGB(&loadedFrame, &frameCount);
+			}
+			if(firstFrame){
+				// define video parameters
+				vRecoder->createVideo(videoFilePath, mat.cols, mat.rows);
+				firstFrame = false;
 			}
-			ifs.close();
-			// unlock current binary file
-			binaryFileMutexes[mutexID]->unlock();
+			// add frame to video
+			vRecoder->addFrame(mat);
 		}
+		ifs.close();
+		// unlock current binary file
+		binaryFileMutexes[mutexID]->unlock();
 	}
 	// release video
 	vRecoder->releaseVideo();
@@ -533,56 +581,98 @@ int FrameManager::createVideo(){
 	return -1;
 }
 
+// adds all frames of a binary file without frame offset table (written by an older version) to the video
+void FrameManager::readFramesSequentially(std::ifstream& ifs, VideoRecorder* vRecoder, bool* firstFrame, unsigned int* frameCount){
+
+	ifs.clear();
+	ifs.seekg(0);
+
+	try{
+		// the frames are stored in a single archive with header
+		boost::archive::binary_iarchive ia(ifs);
+
+		sensor_msgs::Image loadedFrame;
+		while(boost::serialization::try_stream_next(ia, ifs, loadedFrame)){
+			// convert temperature image (sensor_msgs::Image) to RGB image (cv::Mat)
+			cv::Mat mat = convertTemperatureValuesToRGB(&loadedFrame, frameCount);
+			if(*firstFrame){
+				// define video parameters
+				vRecoder->createVideo(videoFilePath, mat.cols, mat.rows);
+				*firstFrame = false;
+			}
+			// add frame to video
+			vRecoder->addFrame(mat);
+		}
+	}
+	catch(const boost::archive::archive_exception &e){
+		ROS_ERROR("Could not read frames from binary file: %s", e.what());
+	}
+}
+
+// deserializes a single frame of an opened binary file by using its frame offset table
+bool FrameManager::readFrame(std::ifstream& ifs, ContainerIndex& index, u_int frame, sensor_msgs::Image& image){
+
+	if(frame >= index.size())
+		return false;
+
+	ifs.clear();
+	ifs.seekg(index.getOffset(frame));
+
+	try{
+		boost::archive::binary_iarchive ia(ifs, boost::archive::no_header);
+		ia >> image;
+	}
+	catch(const boost::archive::archive_exception &e){
+		ROS_ERROR("Could not read frame %d from binary file: %s", frame, e.what());
+		return false;
+	}
+	// the time stamp is not part of the serialized frame
+	image.header.stamp = index.getStamp(frame);
+	return true;
+}
+
+// loads a single temperature frame (e.g. for a thumbnail) out of the binary file binaryIndex without reading the frames before it
+bool FrameManager::loadFrame(u_int binaryIndex, u_int frame, sensor_msgs::Image& image){
+
+	if(binaryIndex >= fpv/fpb)
+		return false;
+
+	std::stringstream inputFileName;
+	inputFileName << binaryFilePath << binaryIndex << ".bin";
+
+	boost::mutex::scoped_lock lock(*binaryFileMutexes[binaryIndex]);
+	std::ifstream ifs(inputFileName.str().c_str(), std::ios::in | std::ios::binary);
+
+	ContainerIndex index;
+	return ifs.is_open() && index.read(ifs) && readFrame(ifs, index, frame, image);
+}
+
 cv::Mat FrameManager::convertTemperatureValuesToRGB(sensor_msgs::Image* frame, unsigned int* frameCount){
 
-	unsigned char* buffer = NULL;
-	buffer = new unsigned char[frame->width * frame->height * 3];
-	
+	std::vector<unsigned char> buffer(frame->width * frame->height * 3);
+
 	unsigned short* data = (unsigned short*)&frame->data[0];
 
 	iBuilder.setData(frame->width, frame->height, data);	
-	iBuilder.convertTemperatureToPaletteImage(buffer, true);
-
-	// create RGB sensor_msgs::image
-	sensor_msgs::Image rgb_img;
-	rgb_img.header.frame_id = "thermal_image_view";
-	rgb_img.height 	        = frame->height;
-	rgb_img.width 	        = frame->width;
-	rgb_img.encoding        = "rgb8";
-	rgb_img.step		    = frame->width*3;
-	rgb_img.data.resize(rgb_img.height*rgb_img.step);
+	iBuilder.convertTemperatureToPaletteImage(&buffer[0], true);
 
 	*frameCount = *frameCount + 1;
-	rgb_img.header.seq      = *frameCount;
-	rgb_img.header.stamp    = ros::Time::now();
 
-	for(unsigned int i=0; i< frame->width* frame->height*3; i++)
-	{
-		rgb_img.data[i] = buffer[i];
-	}
+	// reorder the RGB palette image to BGR
+	cv::Mat rgb(frame->height, frame->width, CV_8UC3, &buffer[0]);
+	cv::Mat mat;
+	cv::cvtColor(rgb, mat, CV_RGB2BGR);
 
-	cv_bridge::CvImageConstPtr cvptrS;
-	try
-	{
-		// convert the sensor_msgs::Image to cv_bridge::CvImageConstPtr (cv::Mat)
-		cvptrS = cv_bridge::toCvShare(rgb_img, cvptrS, sensor_msgs::image_encodings::BGR8);
-		cv::Mat mat = cvptrS->image;
+	// show frame, if configured in the launch file
+	if(showFrame)
+		displayFrame(&mat);
 
-		// show frame, if configured in the launch file
-		if(showFrame)
-			displayFrame(&mat);
-	}
-	catch (cv_bridge::Exception& e)
-	{
-		ROS_ERROR("cv_bridge exception: %s", e.what());
-	}
-	return cvptrS->image;
+	return mat;
 }
 
+// hands the frame over to the preview thread (dropped if the preview is busy or the rate limit is reached)
 void FrameManager::displayFrame(cv::Mat* mat){
-	cv::namedWindow( "Display window", CV_WINDOW_AUTOSIZE );
-	cv::imshow( "Display window", *mat );
-	cv::waitKey(1);
+	preview->show(*mat);
 }
 
 void FrameManager::startSnapshots(int interval){
@@ -607,7 +697,11 @@ void FrameManager::createSnapshots(int interval){
 			std::vector<sensor_msgs::Image>* currentCache = getCurrentCache();
 
 			if(currentCache->size() > 0){
-				sensor_msgs::Image img = currentCache->at(currentCache->size()-1);
+				// duplicate frames are cached without data -> use the last full frame
+				int last = currentCache->size()-1;
+				while(last > 0 && currentCache->at(last).data.empty())
+					last--;
+				sensor_msgs::Image img = currentCache->at(last);
 
 				// file name and path to the image files
 				// file name is the current system time stamp
@@ -65,6 +65,12 @@
 #include "frameManager.h"
 #include "videoRecorder.h"
 #include "videoRecorder.cpp"
+#include "containerIndex.h"
+#include "containerIndex.cpp"
+#include "frameDeduplicator.h"
+#include "frameDeduplicator.cpp"
+#include "framePreview.h"
+#include "framePreview.cpp"
 // libraries
 #include <boost/thread.hpp>
 #include <vector>
@@ -92,6 +98,7 @@ public:
 	bool isLiveStreamRunning(){return liveStreamRunning;};
 	void startLiveStream();
 	void stopLiveStream();
+	bool loadFrame(u_int binaryIndex, u_int frame, sensor_msgs::Image& image);
 
 private:
 
@@ -100,6 +107,8 @@ private:
 	void verifyCacheSize();
 	void storeCache(std::vector<sensor_msgs::Image>* cache, bool* threadActive);
 	int createVideo();
+	bool readFrame(std::ifstream& ifs, ContainerIndex& index, u_int frame, sensor_msgs::Image& image);
+	void readFramesSequentially(std::ifstream& ifs, VideoRecorder* vRecoder, bool* firstFrame, unsigned int* frameCount);
 	std::vector<sensor_msgs::Image>* getCurrentCache();
 	std::vector<cv::Mat>* getCurrentLiveStreamCache();
 	void storeFrame(sensor_msgs::Image frame);
@@ -140,9 +149,13 @@ private:
 	u_int binaryFileIndex;
 	std::vector<boost::mutex*> binaryFileMutexes;
 
+	// static scene deduplication (duplicates are cached without data)
+	FrameDeduplicator deduplicator;
+
 	// termo-to-rgb converter
 	optris::ImageBuilder iBuilder;
 	bool showFrame;
+	FramePreview* preview;		// display thread for showFrame
 
 	// output video parameters
 	u_int vfr;			// video frame rate
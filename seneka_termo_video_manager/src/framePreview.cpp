@@ -0,0 +1,150 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ *   Copyright (c) 2012 \n
+ *   Fraunhofer Institute for Manufacturing Engineering
+ *   and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ *   Project name: SENEKA
+ * \note
+ *   ROS stack name: SENEKA
+ * \note
+ *   ROS package name: seneka_termo_video_manager
+ *
+ * \author
+ *   Author: Johannes Goth (cmm-jg)
+ * \author
+ *   Supervised by: Christophe Maufroy (cmm)
+ *
+ * \date Date of creation: 19.10.2026
+ *
+ * \brief
+ *   framePreview.cpp
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     - Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer. \n
+ *     - Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution. \n
+ *     - Neither the name of the Fraunhofer Institute for Manufacturing
+ *       Engineering and Automation (IPA) nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#include "framePreview.h"
+#include <boost/bind.hpp>
+#include <opencv2/highgui/highgui.hpp>
+
+FramePreview::FramePreview(std::string windowName, double maxRate){
+	this->windowName = windowName;
+	minInterval = boost::posix_time::microseconds(maxRate > 0 ? (long)(1000000 / maxRate) : 0);
+	frameAvailable = false;
+	running = false;
+}
+
+FramePreview::~FramePreview(){
+	stop();
+}
+
+void FramePreview::start(){
+	boost::mutex::scoped_lock lock(mailboxMutex);
+	if(!running){
+		running = true;
+		displayThread = boost::thread(boost::bind(&FramePreview::display, this));
+	}
+}
+
+void FramePreview::stop(){
+	{
+		boost::mutex::scoped_lock lock(mailboxMutex);
+		if(!running)
+			return;
+		running = false;
+	}
+	mailboxCondition.notify_one();
+	displayThread.join();
+}
+
+// hands a frame over to the display thread, never waits for the GUI
+// called by the subscriber callback and by the video and snapshot threads
+void FramePreview::show(const cv::Mat& frame){
+
+	if(frame.empty())
+		return;
+
+	// rate limit before copying the frame
+	{
+		boost::mutex::scoped_lock lock(mailboxMutex);
+		if(!running)
+			return;
+
+		boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+		if(!lastAccepted.is_not_a_date_time() && now - lastAccepted < minInterval)
+			return;
+		lastAccepted = now;
+	}
+
+	// the caller might reuse or release the frame memory, so the mailbox gets its own copy
+	cv::Mat copy = frame.clone();
+	{
+		boost::mutex::scoped_lock lock(mailboxMutex);
+		mailbox = copy;		// a frame which was not displayed yet is dropped
+		frameAvailable = true;
+	}
+	mailboxCondition.notify_one();
+}
+
+// display thread: all highgui calls are done in this thread
+void FramePreview::display(){
+
+	cv::namedWindow(windowName, CV_WINDOW_AUTOSIZE);
+
+	while(true){
+		cv::Mat frame;
+		{
+			boost::mutex::scoped_lock lock(mailboxMutex);
+			if(running && !frameAvailable)
+				mailboxCondition.timed_wait(lock, boost::posix_time::milliseconds(100));
+
+			if(!running)
+				break;
+
+			if(frameAvailable){
+				frame = mailbox;
+				mailbox = cv::Mat();
+				frameAvailable = false;
+			}
+		}
+		if(!frame.empty())
+			cv::imshow(windowName, frame);
+		// also keeps the window responsive if no frames arrive
+		cv::waitKey(1);
+	}
+	cv::destroyWindow(windowName);
+}
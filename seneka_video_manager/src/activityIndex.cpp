@@ -0,0 +1,175 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ *   Copyright (c) 2012 \n
+ *   Fraunhofer Institute for Manufacturing Engineering
+ *   and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ *   Project name: SENEKA
+ * \note
+ *   ROS stack name: SENEKA
+ * \note
+ *   ROS package name: seneka_video_manager
+ *
+ * \author
+ *   Author: Johannes Goth (cmm-jg)
+ * \author
+ *   Supervised by: Christophe Maufroy (cmm)
+ *
+ * \date Date of creation: 19.10.2026
+ *
+ * \brief
+ *   activityIndex.cpp
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     - Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer. \n
+ *     - Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution. \n
+ *     - Neither the name of the Fraunhofer Institute for Manufacturing
+ *       Engineering and Automation (IPA) nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#include "activityIndex.h"
+#include <opencv2/imgproc/imgproc.hpp>
+#include <fstream>
+#include <sstream>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+ActivityIndex::ActivityIndex(){}
+
+ActivityIndex::~ActivityIndex(){}
+
+// returns the activity score of the frame compared to the previous frame (0 for the first frame)
+float ActivityIndex::score(const cv::Mat& bgr){
+
+	cv::Mat small, thumb;
+	cv::resize(bgr, small, cv::Size(ACTIVITY_THUMB_WIDTH, ACTIVITY_THUMB_HEIGHT), 0, 0, cv::INTER_AREA);
+	cv::cvtColor(small, thumb, CV_BGR2GRAY);
+
+	float activity = 0;
+	if(!previousThumb.empty())
+		activity = (float)sumAbsDiff(thumb.data, previousThumb.data, thumb.total()) / thumb.total();
+
+	previousThumb = thumb;
+	return activity;
+}
+
+// stores the summary of a (re)written container file
+void ActivityIndex::setSegment(u_int container, ros::Time start, ros::Time end, float maxActivity){
+	boost::mutex::scoped_lock lock(segmentMutex);
+
+	if(segments.size() <= container)
+		segments.resize(container+1);
+
+	segments[container].container = container;
+	segments[container].start = start;
+	segments[container].end = end;
+	segments[container].maxActivity = maxActivity;
+}
+
+// rebuilds the summary of a container file from its sidecar file (one line per frame: time stamp and activity score)
+// returns false if the file does not exist or contains no frame
+bool ActivityIndex::loadSegment(u_int container, const std::string& activityFileName){
+
+	std::ifstream ifs(activityFileName.c_str());
+	if(!ifs.is_open())
+		return false;
+
+	ros::Time start, end;
+	float maxActivity = 0;
+	bool found = false;
+
+	std::string line;
+	while(std::getline(ifs, line)){
+		// the time stamp is written as <sec>.<nsec> with nine digits
+		std::istringstream iss(line);
+		u_int32_t sec, nsec;
+		char dot;
+		float activity;
+		if(!(iss >> sec >> dot >> nsec >> activity) || dot != '.')
+			continue;
+
+		ros::Time stamp(sec, nsec);
+		if(!found)
+			start = stamp;
+		end = stamp;
+		if(activity > maxActivity)
+			maxActivity = activity;
+		found = true;
+	}
+
+	if(found)
+		setSegment(container, start, end, maxActivity);
+	return found;
+}
+
+// returns all segments which end after since and contain a frame with a score above threshold, oldest first
+std::vector<ActivityIndex::Segment> ActivityIndex::findSegments(float threshold, ros::Time since){
+	boost::mutex::scoped_lock lock(segmentMutex);
+
+	std::vector<Segment> found;
+	for(u_int i=0; i < segments.size(); i++){
+		if(segments[i].end.isZero() || segments[i].end < since || segments[i].maxActivity <= threshold)
+			continue;
+
+		std::vector<Segment>::iterator it = found.begin();
+		while(it != found.end() && it->start < segments[i].start)
+			it++;
+		found.insert(it, segments[i]);
+	}
+	return found;
+}
+
+// sum of absolute differences of two byte arrays
+u_int32_t ActivityIndex::sumAbsDiff(const unsigned char* a, const unsigned char* b, int length){
+
+	u_int32_t sum = 0;
+	int i = 0;
+
+#ifdef __SSE2__
+	// each _mm_sad_epu8 returns two 16 bit partial sums in the 64 bit lanes
+	__m128i acc = _mm_setzero_si128();
+	for(; i + 16 <= length; i += 16){
+		__m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+		__m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+		acc = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+	}
+	sum = _mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_srli_si128(acc, 8));
+#endif
+
+	for(; i < length; i++)
+		sum += a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+
+	return sum;
+}
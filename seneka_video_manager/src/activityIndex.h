@@ -0,0 +1,110 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ *   Copyright (c) 2012 \n
+ *   Fraunhofer Institute for Manufacturing Engineering
+ *   and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ *   Project name: SENEKA
+ * \note
+ *   ROS stack name: SENEKA
+ * \note
+ *   ROS package name: seneka_video_manager
+ *
+ * \author
+ *   Author: Johannes Goth (cmm-jg)
+ * \author
+ *   Supervised by: Christophe Maufroy (cmm)
+ *
+ * \date Date of creation: 19.10.2026
+ *
+ * \brief
+ *   activityIndex.h
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     - Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer. \n
+ *     - Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution. \n
+ *     - Neither the name of the Fraunhofer Institute for Manufacturing
+ *       Engineering and Automation (IPA) nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#ifndef ACTIVITYINDEX_H_
+#define ACTIVITYINDEX_H_
+
+// libraries
+#include <boost/thread.hpp>
+#include <string>
+#include <vector>
+// ROS includes
+#include "ros/ros.h"
+// openCV includes
+#include "opencv2/core/core.hpp"
+
+// size of the gray thumbnail, which is used to compare consecutive frames
+#define ACTIVITY_THUMB_WIDTH 64
+#define ACTIVITY_THUMB_HEIGHT 48
+
+/* Motion activity of the cached frames
+ * Every incoming frame is downscaled to a small gray thumbnail and compared with the thumbnail of the previous frame.
+ * The activity score is the mean absolute difference per pixel (0 - 255). For each container file the time span and
+ * the maximal score are kept in memory, so segments with activity can be found without reading the container files.
+ * After a restart the summaries of the existing container files are rebuilt from their sidecar files (loadSegment). */
+class ActivityIndex {
+public:
+
+	// activity summary of one container file
+	struct Segment {
+		u_int container;
+		ros::Time start;
+		ros::Time end;
+		float maxActivity;
+	};
+
+	// public member functions
+	ActivityIndex();
+	virtual ~ActivityIndex();
+	float score(const cv::Mat& bgr);
+	void setSegment(u_int container, ros::Time start, ros::Time end, float maxActivity);
+	bool loadSegment(u_int container, const std::string& activityFileName);
+	std::vector<Segment> findSegments(float threshold, ros::Time since);
+
+private:
+
+	// private member functions
+	static u_int32_t sumAbsDiff(const unsigned char* a, const unsigned char* b, int length);
+
+	cv::Mat previousThumb;
+	std::vector<Segment> segments;
+	boost::mutex segmentMutex;
+};
+
+#endif /* ACTIVITYINDEX_H_ */
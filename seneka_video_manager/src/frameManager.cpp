@@ -105,9 +105,11 @@ FrameManager::FrameManager() {
 	usingCacheB = false;
 	storingCacheA = false;
 	storingCacheB = false;
-	cacheA = new std::vector<cv::Mat>;
-	cacheB = new std::vector<cv::Mat>;
+	cacheA = new std::vector<CachedFrame>;
+	cacheB = new std::vector<CachedFrame>;
 	showFrame = false;
+	preview = new FramePreview("Display window", 10);
+	yuvCache = false;
 	snapshotRunning = false;
 	liveStreamRunning = false;
 	stateMachine = ON_DEMAND;
@@ -175,6 +177,26 @@ FrameManager::FrameManager(ros::NodeHandle &pnHandle) {
 	else
 		pnHandle.getParam("showFrame", showFrame);
 
+	double previewRate;
+	if(!pnHandle.hasParam("previewRate")){
+		ROS_WARN("Used default parameter for previewRate [10]");
+		previewRate = 10;
+	}
+	else
+		pnHandle.getParam("previewRate", previewRate);
+
+	// frames are shown in a separate thread, so the GUI never slows down caching or video creation
+	preview = new FramePreview("Display window", previewRate);
+	if(showFrame)
+		preview->start();
+
+	if(!pnHandle.hasParam("yuvCache")){
+		ROS_WARN("Used default parameter for yuvCache [false]");
+		yuvCache = false;
+	}
+	else
+		pnHandle.getParam("yuvCache", yuvCache);
+
 	// initialize fixed parameters
 	videoCodec = CV_FOURCC('D','I','V','X');
 	binaryFileIndex = 0;
@@ -184,8 +206,8 @@ FrameManager::FrameManager(ros::NodeHandle &pnHandle) {
 	usingCacheB = false;
 	storingCacheA = false;
 	storingCacheB = false;
-	cacheA = new std::vector<cv::Mat>;
-	cacheB = new std::vector<cv::Mat>;
+	cacheA = new std::vector<CachedFrame>;
+	cacheB = new std::vector<CachedFrame>;
 	snapshotRunning = false;
 	liveStreamRunning = false;
 	stateMachine = ON_DEMAND;
@@ -193,9 +215,21 @@ FrameManager::FrameManager(ros::NodeHandle &pnHandle) {
 	for(int i=0; i < (int)(fpv/fpb)+1; i++){
 		binaryFileMutexes.push_back(new boost::mutex());
 	}
+
+	// the container files of a previous run stay queryable until they are overwritten
+	u_int loaded = 0;
+	for(u_int i=0; i < fpv/fpb; i++){
+		std::stringstream activityFileName;
+		activityFileName << binaryFilePath << i << ".act";
+		if(activityIndex.loadSegment(i, activityFileName.str()))
+			loaded++;
+	}
+	if(loaded > 0)
+		ROS_INFO("Loaded the activity of %u existing container files", loaded);
 }
 
 FrameManager::~FrameManager() {
+	delete preview;
 	delete cacheA;
 	delete cacheB;
 }
@@ -208,8 +242,20 @@ void FrameManager::processFrame(const sensor_msgs::Image& img){
 	{
 		// convert sensor_msgs::Image to cv_bridge::CvImageConstPtr
 		cvptrS = cv_bridge::toCvShare(img, cvptrS, sensor_msgs::image_encodings::BGR8);
+		// compare current frame with the previous one
+		float activity = activityIndex.score(cvptrS->image);
 		// caching current frame into memory
-		cacheFrame(cvptrS->image);
+		if(yuvCache && YUVConverter::isConvertible(cvptrS->image)){
+			// planar YUV 4:2:0 needs half of the memory and disk space of BGR8
+			cv::Mat yuv;
+			YUVConverter::bgrToI420(cvptrS->image, yuv);
+			cacheFrame(yuv, img.header.stamp, activity);
+		}
+		else{
+			if(yuvCache)
+				ROS_WARN_ONCE("Frame size %dx%d is not even, caching BGR8 frames", cvptrS->image.cols, cvptrS->image.rows);
+			cacheFrame(cvptrS->image, img.header.stamp, activity);
+		}
 
 		if(stateMachine == LIVE_STREAM){
 			// display current frame
@@ -225,14 +271,19 @@ void FrameManager::processFrame(const sensor_msgs::Image& img){
 	}
 }
 
-void FrameManager::cacheFrame(cv::Mat frame){
+void FrameManager::cacheFrame(cv::Mat frame, ros::Time stamp, float activity){
 	//ROS_INFO("cacheFrame ... ");
 
-	std::vector<cv::Mat>* currentCache = getCurrentCache();
-	currentCache->push_back(frame);
+	CachedFrame cachedFrame;
+	cachedFrame.image = frame;
+	cachedFrame.stamp = stamp;
+	cachedFrame.activity = activity;
+
+	std::vector<CachedFrame>* currentCache = getCurrentCache();
+	currentCache->push_back(cachedFrame);
 }
 
-std::vector<cv::Mat>* FrameManager::getCurrentCache(){
+std::vector<CachedFrame>* FrameManager::getCurrentCache(){
 	//ROS_INFO("getCurrentCache ... ");
 
 	// verifying the sizes of memory buffers
@@ -279,17 +330,23 @@ void FrameManager::verifyCacheSize(){
 
 }
 
-void FrameManager::storeCache(std::vector<cv::Mat>* cache, bool* threadActive){
+void FrameManager::storeCache(std::vector<CachedFrame>* cache, bool* threadActive){
 
 	ROS_INFO("storeCache into binary file...");
 	// define fileStorage-filename
 	std::stringstream fileName;
 	fileName << binaryFilePath << binaryFileIndex << ".bin";
 
+	// sidecar file with the activity scores of the frames
+	std::stringstream activityFileName;
+	activityFileName << binaryFilePath << binaryFileIndex << ".act";
+
 	// lock current binary file as output
 	binaryFileMutexes[binaryFileIndex]->lock();
 	// open outputFile
 	std::ofstream ofs(fileName.str().c_str(), std::ios::out | std::ios::binary);
+	std::ofstream aofs(activityFileName.str().c_str(), std::ios::out);
+	float maxActivity = 0;
 
 	// scope is required to ensure archive and filtering stream buffer go out of scope
 	// before stream
@@ -299,19 +356,37 @@ void FrameManager::storeCache(std::vector<cv::Mat>* cache, bool* threadActive){
 		//		      out.push(io::zlib_compressor(io::zlib::best_speed));
 		//		      out.push(ofs);
 
-		boost::archive::binary_oarchive oa(ofs);
+		ContainerIndex index;
 
 		// writes each frame which is stored in cache into binary file
-		for (std::vector<cv::Mat>::iterator it = cache->begin() ; it != cache->end(); it++){
+		for (std::vector<CachedFrame>::iterator it = cache->begin() ; it != cache->end(); it++){
+			// remember where the frame starts, so it can be read without reading the frames before it
+			index.addFrame(ofs.tellp(), it->stamp);
+
 			// writes frame per frame into binary file, using cv::Mat serialization
-			oa << *it;
+			// every frame gets its own archive without header, so it can be deserialized on its own
+			boost::archive::binary_oarchive oa(ofs, boost::archive::no_header);
+			oa << it->image;
+
+			// one line per frame: time stamp and activity score
+			aofs << it->stamp << " " << it->activity << std::endl;
+			if(it->activity > maxActivity)
+				maxActivity = it->activity;
 		}
+
+		// append frame offset table
+		if(!index.write(ofs))
+			ROS_ERROR("Could not write frame offset table into %s", fileName.str().c_str());
 	}
 	// close file
 	ofs.close();
+	aofs.close();
 	// unlock current binary file
 	binaryFileMutexes[binaryFileIndex]->unlock();
 
+	if(!cache->empty())
+		activityIndex.setSegment(binaryFileIndex, cache->front().stamp, cache->back().stamp, maxActivity);
+
 	if(binaryFileIndex < (fpv/fpb)-1)
 		binaryFileIndex++;
 	else{
@@ -396,51 +471,34 @@ int FrameManager::createVideo(){
 		// open inputFile
 		std::ifstream ifs(inputFileName.str().c_str(), std::ios::in | std::ios::binary);
 
-		// scope is required to ensure archive and filtering stream buffer go out of scope
-		// before stream
-		{
-			//			// decompressing frame size
-			//			io::filtering_streambuf<io::input> in;
-			//			in.push(io::zlib_decompressor());
-			//			in.push(ifs);
+		// read frame offset table of the binary file
+		ContainerIndex index;
+		if(!index.read(ifs)){
+			ROS_WARN("No frame offset table in %s, reading the frames sequentially", inputFileName.str().c_str());
+			readFramesSequentially(ifs, vRecoder, &firstFrame);
+		}
 
-			boost::archive::binary_iarchive ia(ifs);
+		for(u_int frame=0; frame < index.size(); frame++){
+			cv::Mat loadedFrame;
 
-			bool hasContent = true;
-			while (hasContent)
-			{
-				cv::Mat loadedFrame;
-				if(firstFrame){
-					// try to read image from binary file
-					hasContent = boost::serialization::try_stream_next(ia, ifs, loadedFrame);
-					if (hasContent == true){
-						vRecoder->createVideo(videoFilePath, loadedFrame.cols, loadedFrame.rows);
-						// add frame to video
-						vRecoder->addFrame(loadedFrame);
-						firstFrame = false;
-
-						// display current frame
-						if(showFrame)
-							displayFrame(&loadedFrame);
-					}
-				}
-				else{
-					// try to read image from binary file
-					hasContent = boost::serialization::try_stream_next(ia, ifs, loadedFrame);
-					// add frame to video
-					if (hasContent == true){
-						vRecoder->addFrame(loadedFrame);
-
-						// display current frame
-						if(showFrame)
-							displayFrame(&loadedFrame);
-					}
-				}
+			// try to read image from binary file
+			if(!readFrame(ifs, index, frame, loadedFrame))
+				break;
+
+			if(firstFrame){
+				vRecoder->createVideo(videoFilePath, loadedFrame.cols, loadedFrame.rows);
+				firstFrame = false;
 			}
-			ifs.close();
-			// unlock current binary file
-			binaryFileMutexes[mutexID]->unlock();
+			// add frame to video
+			vRecoder->addFrame(loadedFrame);
+
+			// display current frame
+			if(showFrame)
+				displayFrame(&loadedFrame);
 		}
+		ifs.close();
+		// unlock current binary file
+		binaryFileMutexes[mutexID]->unlock();
 	}
 	// release video
 	vRecoder->releaseVideo();
@@ -450,10 +508,93 @@ int FrameManager::createVideo(){
 	return -1;
 }
 
+// adds all frames of a binary file without frame offset table (written by an older version) to the video
+void FrameManager::readFramesSequentially(std::ifstream& ifs, VideoRecorder* vRecoder, bool* firstFrame){
+
+	ifs.clear();
+	ifs.seekg(0);
+
+	try{
+		// the frames are stored in a single archive with header
+		boost::archive::binary_iarchive ia(ifs);
+
+		cv::Mat loadedFrame;
+		while(boost::serialization::try_stream_next(ia, ifs, loadedFrame)){
+			if(*firstFrame){
+				vRecoder->createVideo(videoFilePath, loadedFrame.cols, loadedFrame.rows);
+				*firstFrame = false;
+			}
+			// add frame to video
+			vRecoder->addFrame(loadedFrame);
+
+			// display current frame
+			if(showFrame)
+				displayFrame(&loadedFrame);
+		}
+	}
+	catch(const boost::archive::archive_exception &e){
+		ROS_ERROR("Could not read frames from binary file: %s", e.what());
+	}
+}
+
+// deserializes a single frame of an opened binary file by using its frame offset table
+bool FrameManager::readFrame(std::ifstream& ifs, ContainerIndex& index, u_int frame, cv::Mat& image){
+
+	if(frame >= index.size())
+		return false;
+
+	ifs.clear();
+	ifs.seekg(index.getOffset(frame));
+
+	cv::Mat cached;
+	try{
+		boost::archive::binary_iarchive ia(ifs, boost::archive::no_header);
+		ia >> cached;
+	}
+	catch(const boost::archive::archive_exception &e){
+		ROS_ERROR("Could not read frame %d from binary file: %s", frame, e.what());
+		return false;
+	}
+	toBGR(cached, image);
+	return true;
+}
+
+// returns a cached frame as BGR8, frames cached as YUV 4:2:0 are converted back
+void FrameManager::toBGR(const cv::Mat& cached, cv::Mat& bgr){
+	if(cached.type() == CV_8UC1)
+		YUVConverter::i420ToBgr(cached, bgr);
+	else
+		bgr = cached;
+}
+
+// loads a single frame (e.g. for a thumbnail) out of the binary file binaryIndex without reading the frames before it
+bool FrameManager::loadFrame(u_int binaryIndex, u_int frame, cv::Mat& image, ros::Time& stamp){
+
+	if(binaryIndex >= fpv/fpb)
+		return false;
+
+	std::stringstream inputFileName;
+	inputFileName << binaryFilePath << binaryIndex << ".bin";
+
+	boost::mutex::scoped_lock lock(*binaryFileMutexes[binaryIndex]);
+	std::ifstream ifs(inputFileName.str().c_str(), std::ios::in | std::ios::binary);
+
+	ContainerIndex index;
+	if(!ifs.is_open() || !index.read(ifs) || !readFrame(ifs, index, frame, image))
+		return false;
+
+	stamp = index.getStamp(frame);
+	return true;
+}
+
+// returns the segments (container files) of the last minutes, which contain a frame with an activity above threshold
+std::vector<ActivityIndex::Segment> FrameManager::getActivity(float threshold, int minutes){
+	return activityIndex.findSegments(threshold, ros::Time::now() - ros::Duration(minutes * 60.0));
+}
+
+// hands the frame over to the preview thread (dropped if the preview is busy or the rate limit is reached)
 void FrameManager::displayFrame(cv::Mat* mat){
-	cv::namedWindow( "Display window", CV_WINDOW_AUTOSIZE );
-	cv::imshow( "Display window", *mat );
-	cv::waitKey(1);
+	preview->show(*mat);
 }
 
 void FrameManager::startSnapshots(int interval){
@@ -474,10 +615,11 @@ void FrameManager::createSnapshots(int interval){
 	while(true){
 
 		std::stringstream imgFile;
-		std::vector<cv::Mat>* currentCache = getCurrentCache();
+		std::vector<CachedFrame>* currentCache = getCurrentCache();
 
 		if(currentCache->size() > 0){
-			cv::Mat img = currentCache->at(currentCache->size()-1);
+			cv::Mat img;
+			toBGR(currentCache->at(currentCache->size()-1).image, img);
 
 			// file name and path to the image files
 			// file name is the current system time stamp
@@ -65,6 +65,14 @@
 #include "frameManager.h"
 #include "videoRecorder.h"
 #include "videoRecorder.cpp"
+#include "containerIndex.h"
+#include "containerIndex.cpp"
+#include "yuvConverter.h"
+#include "yuvConverter.cpp"
+#include "activityIndex.h"
+#include "activityIndex.cpp"
+#include "framePreview.h"
+#include "framePreview.cpp"
 // libraries
 #include <boost/thread.hpp>
 #include <vector>
@@ -78,6 +86,13 @@
 #include <opencv2/imgproc/imgproc.hpp>
 #include <opencv2/highgui/highgui.hpp>
 
+// cached frame and the time stamp of its sensor_msgs::Image
+struct CachedFrame {
+	cv::Mat image;		// BGR8 (CV_8UC3) or planar YUV 4:2:0 (CV_8UC1, see YUVConverter)
+	ros::Time stamp;
+	float activity;		// activity score compared to the previous frame (see ActivityIndex)
+};
+
 class FrameManager {
 public:
 	// public member functions
@@ -92,17 +107,22 @@ public:
 	bool isLiveStreamRunning(){return liveStreamRunning;};
 	void startLiveStream();
 	void stopLiveStream();
+	bool loadFrame(u_int binaryIndex, u_int frame, cv::Mat& image, ros::Time& stamp);
+	std::vector<ActivityIndex::Segment> getActivity(float threshold, int minutes);
 
 private:
 
 	// private member functions
-	void cacheFrame(cv::Mat frame);
+	void cacheFrame(cv::Mat frame, ros::Time stamp, float activity);
 	void verifyCacheSize();
-	void storeCache(std::vector<cv::Mat>* cache, bool* threadActive);
+	void storeCache(std::vector<CachedFrame>* cache, bool* threadActive);
 	int createVideo();
-	std::vector<cv::Mat>* getCurrentCache();
+	bool readFrame(std::ifstream& ifs, ContainerIndex& index, u_int frame, cv::Mat& image);
+	void readFramesSequentially(std::ifstream& ifs, VideoRecorder* vRecoder, bool* firstFrame);
+	std::vector<CachedFrame>* getCurrentCache();
 	void storeFrame(cv::Mat frame);
 	void displayFrame(cv::Mat* mat);
+	void toBGR(const cv::Mat& cached, cv::Mat& bgr);
 	void createSnapshots(int interval);
 
 	// state machine
@@ -117,8 +137,9 @@ private:
 	bool createVideoActive;
 	bool usingCacheA;
 	bool usingCacheB;
-	std::vector<cv::Mat>* cacheA;
-	std::vector<cv::Mat>* cacheB;
+	std::vector<CachedFrame>* cacheA;
+	std::vector<CachedFrame>* cacheB;
+	bool yuvCache;		// cache and store frames as YUV 4:2:0 instead of BGR8
 
 	// file storage parameters
 	std::string binaryFilePath;
@@ -127,8 +148,12 @@ private:
 	u_int binaryFileIndex;
 	std::vector<boost::mutex*> binaryFileMutexes;
 
+	// motion activity of the cached frames
+	ActivityIndex activityIndex;
+
 	// termo-to-rgb converter
 	bool showFrame;
+	FramePreview* preview;		// display thread for showFrame
 
 	// output video parameters
 	u_int vfr;			// video frame rate
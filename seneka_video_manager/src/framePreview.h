@@ -0,0 +1,103 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ *   Copyright (c) 2012 \n
+ *   Fraunhofer Institute for Manufacturing Engineering
+ *   and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ *   Project name: SENEKA
+ * \note
+ *   ROS stack name: SENEKA
+ * \note
+ *   ROS package name: seneka_video_manager
+ *
+ * \author
+ *   Author: Johannes Goth (cmm-jg)
+ * \author
+ *   Supervised by: Christophe Maufroy (cmm)
+ *
+ * \date Date of creation: 19.10.2026
+ *
+ * \brief
+ *   framePreview.h
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     - Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer. \n
+ *     - Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution. \n
+ *     - Neither the name of the Fraunhofer Institute for Manufacturing
+ *       Engineering and Automation (IPA) nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#ifndef FRAMEPREVIEW_H_
+#define FRAMEPREVIEW_H_
+
+// libraries
+#include <boost/thread.hpp>
+#include <string>
+// openCV includes
+#include "opencv2/core/core.hpp"
+
+/* Preview window with its own display thread
+ * show() puts a copy of the frame into a mailbox with a single slot and returns immediately. The display thread
+ * takes the latest frame out of the mailbox and shows it, frames which are replaced before they are displayed are
+ * dropped. Frames arriving faster than the maximal preview rate are dropped before they are copied. So the GUI never
+ * slows down the caller. */
+class FramePreview {
+public:
+
+	// public member functions
+	FramePreview(std::string windowName, double maxRate);
+	virtual ~FramePreview();
+	void start();
+	void stop();
+	void show(const cv::Mat& frame);
+
+private:
+
+	// private member functions
+	void display();
+
+	std::string windowName;
+	boost::posix_time::time_duration minInterval;	// minimal time between two displayed frames
+	boost::posix_time::ptime lastAccepted;			// guarded by mailboxMutex, like running
+
+	// mailbox with a single slot
+	cv::Mat mailbox;
+	bool frameAvailable;
+	boost::mutex mailboxMutex;
+	boost::condition_variable mailboxCondition;
+
+	boost::thread displayThread;
+	bool running;
+};
+
+#endif /* FRAMEPREVIEW_H_ */
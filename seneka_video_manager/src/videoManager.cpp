@@ -73,6 +73,7 @@
 #include "seneka_video_manager/getVideo.h"
 #include "seneka_video_manager/getSnapShots.h"
 #include "seneka_video_manager/getLiveStream.h"
+#include "seneka_video_manager/getActivity.h"
 
 namespace enc = sensor_msgs::image_encodings;
 
@@ -134,6 +135,26 @@ bool getVideoCallback(seneka_video_manager::getVideo::Request &req, seneka_video
 	}
 }
 
+bool getActivityCallback(seneka_video_manager::getActivity::Request &req, seneka_video_manager::getActivity::Response &res){
+
+	ROS_INFO("Remote getActivity call ...");
+
+	if(req.minutes <= 0){
+		ROS_ERROR("Invalid getActivity-service time span %d minutes", (int)req.minutes);
+		return false;
+	}
+
+	// segments with activity above the threshold, oldest first
+	std::vector<ActivityIndex::Segment> segments = fManager->getActivity(req.threshold, req.minutes);
+	for(u_int i=0; i < segments.size(); i++){
+		res.containers.push_back(segments[i].container);
+		res.startTimes.push_back(segments[i].start);
+		res.endTimes.push_back(segments[i].end);
+		res.maxActivity.push_back(segments[i].maxActivity);
+	}
+	return true;
+}
+
 int main(int argc, char **argv)
 {
 	ros::init(argc, argv, "video_manager");
@@ -157,6 +178,7 @@ int main(int argc, char **argv)
 	ros::ServiceServer videoService = nHandle.advertiseService("getVideo", getVideoCallback);
 	ros::ServiceServer snapShotService = nHandle.advertiseService("getSnapShots", getSnapShotCallback);
 	ros::ServiceServer liveStreamService = nHandle.advertiseService("getLiveStream", getLiveStreamCallback);
+	ros::ServiceServer activityService = nHandle.advertiseService("getActivity", getActivityCallback);
 	ROS_INFO("subscribing for thermal_image ...");
 	// subscribed on topic THERMAL_IMAGE
 	ros::Subscriber sub = nHandle.subscribe(inputTopic, 2, processFrameCallback);
@@ -0,0 +1,330 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ *   Copyright (c) 2012 \n
+ *   Fraunhofer Institute for Manufacturing Engineering
+ *   and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ *   Project name: SENEKA
+ * \note
+ *   ROS stack name: SENEKA
+ * \note
+ *   ROS package name: seneka_video_manager
+ *
+ * \author
+ *   Author: Johannes Goth (cmm-jg)
+ * \author
+ *   Supervised by: Christophe Maufroy (cmm)
+ *
+ * \date Date of creation: 19.10.2026
+ *
+ * \brief
+ *   yuvConverter.cpp
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     - Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer. \n
+ *     - Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution. \n
+ *     - Neither the name of the Fraunhofer Institute for Manufacturing
+ *       Engineering and Automation (IPA) nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#include "yuvConverter.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// fixed point coefficients (BGR -> YUV in 8 bit, YUV -> BGR in 7 bit fraction)
+#define YUV_Y_R 77
+#define YUV_Y_G 150
+#define YUV_Y_B 29
+#define YUV_U_R 43
+#define YUV_U_G 85
+#define YUV_V_G 107
+#define YUV_V_B 21
+#define YUV_R_V 179
+#define YUV_G_U 44
+#define YUV_G_V 91
+#define YUV_B_U 227
+
+static inline unsigned char saturate(int x){
+	return (unsigned char)(x < 0 ? 0 : (x > 255 ? 255 : x));
+}
+
+#ifdef __SSE2__
+
+/* One step of the deinterleaving network: the 96 bytes of the six registers are treated as one sequence and the
+ * first half is interleaved with the second half. Five steps split 32 interleaved BGR pixels into 32 blue, 32 green
+ * and 32 red values (two registers each). */
+static inline void interleaveHalves(__m128i* v){
+	__m128i t0 = _mm_unpacklo_epi8(v[0], v[3]);
+	__m128i t1 = _mm_unpackhi_epi8(v[0], v[3]);
+	__m128i t2 = _mm_unpacklo_epi8(v[1], v[4]);
+	__m128i t3 = _mm_unpackhi_epi8(v[1], v[4]);
+	__m128i t4 = _mm_unpacklo_epi8(v[2], v[5]);
+	__m128i t5 = _mm_unpackhi_epi8(v[2], v[5]);
+	v[0] = t0; v[1] = t1; v[2] = t2; v[3] = t3; v[4] = t4; v[5] = t5;
+}
+
+// inverse of interleaveHalves: even bytes of the sequence form the first half, odd bytes the second half
+static inline void splitEvenOdd(__m128i* v){
+	const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+	__m128i t0 = _mm_packus_epi16(_mm_and_si128(v[0], lowBytes), _mm_and_si128(v[1], lowBytes));
+	__m128i t1 = _mm_packus_epi16(_mm_and_si128(v[2], lowBytes), _mm_and_si128(v[3], lowBytes));
+	__m128i t2 = _mm_packus_epi16(_mm_and_si128(v[4], lowBytes), _mm_and_si128(v[5], lowBytes));
+	__m128i t3 = _mm_packus_epi16(_mm_srli_epi16(v[0], 8), _mm_srli_epi16(v[1], 8));
+	__m128i t4 = _mm_packus_epi16(_mm_srli_epi16(v[2], 8), _mm_srli_epi16(v[3], 8));
+	__m128i t5 = _mm_packus_epi16(_mm_srli_epi16(v[4], 8), _mm_srli_epi16(v[5], 8));
+	v[0] = t0; v[1] = t1; v[2] = t2; v[3] = t3; v[4] = t4; v[5] = t5;
+}
+
+// loads 32 BGR pixels and returns them as b[0..1], g[2..3], r[4..5]
+static inline void loadBGR32(const unsigned char* src, __m128i* v){
+	for(int i=0; i < 6; i++)
+		v[i] = _mm_loadu_si128((const __m128i*)(src + 16*i));
+	for(int i=0; i < 5; i++)
+		interleaveHalves(v);
+}
+
+// stores 32 pixels given as b[0..1], g[2..3], r[4..5] as interleaved BGR pixels
+static inline void storeBGR32(unsigned char* dst, __m128i* v){
+	for(int i=0; i < 5; i++)
+		splitEvenOdd(v);
+	for(int i=0; i < 6; i++)
+		_mm_storeu_si128((__m128i*)(dst + 16*i), v[i]);
+}
+
+// luma of 16 pixels
+static inline __m128i lumaBGR16(__m128i b, __m128i g, __m128i r){
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i cr = _mm_set1_epi16(YUV_Y_R);
+	const __m128i cg = _mm_set1_epi16(YUV_Y_G);
+	const __m128i cb = _mm_set1_epi16(YUV_Y_B);
+	const __m128i round = _mm_set1_epi16(128);
+
+	__m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(r, zero), cr),
+			_mm_mullo_epi16(_mm_unpacklo_epi8(g, zero), cg)),
+			_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), cb), round));
+	__m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(r, zero), cr),
+			_mm_mullo_epi16(_mm_unpackhi_epi8(g, zero), cg)),
+			_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), cb), round));
+
+	return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+}
+
+// average of the 2x2 blocks of 16 pixels in two rows (8 results)
+static inline __m128i average2x2(__m128i row0, __m128i row1){
+	const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+	__m128i sum = _mm_add_epi16(_mm_add_epi16(_mm_and_si128(row0, lowBytes), _mm_srli_epi16(row0, 8)),
+			_mm_add_epi16(_mm_and_si128(row1, lowBytes), _mm_srli_epi16(row1, 8)));
+	return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(2)), 2);
+}
+
+#endif
+
+bool YUVConverter::isConvertible(const cv::Mat& bgr){
+	return bgr.type() == CV_8UC3 && bgr.cols % 2 == 0 && bgr.rows % 2 == 0 && bgr.cols > 0 && bgr.rows > 0;
+}
+
+bool YUVConverter::bgrToI420(const cv::Mat& bgr, cv::Mat& yuv){
+
+	if(!isConvertible(bgr))
+		return false;
+
+	int width = bgr.cols;
+	int height = bgr.rows;
+
+	// the planes are stored one after the other in a continuous single channel matrix
+	yuv.create(height + height/2, width, CV_8UC1);
+	unsigned char* yPlane = yuv.data;
+	unsigned char* uPlane = yPlane + width * height;
+	unsigned char* vPlane = uPlane + (width/2) * (height/2);
+
+	for(int row=0; row < height; row+=2){
+		bgrToI420Rows(bgr.ptr(row), bgr.ptr(row+1), yPlane + row * width, yPlane + (row+1) * width,
+				uPlane + (row/2) * (width/2), vPlane + (row/2) * (width/2), width);
+	}
+	return true;
+}
+
+bool YUVConverter::i420ToBgr(const cv::Mat& yuv, cv::Mat& bgr){
+
+	if(yuv.type() != CV_8UC1 || yuv.rows % 3 != 0 || yuv.cols % 2 != 0 || !yuv.isContinuous())
+		return false;
+
+	int width = yuv.cols;
+	int height = (yuv.rows / 3) * 2;
+
+	bgr.create(height, width, CV_8UC3);
+	const unsigned char* yPlane = yuv.data;
+	const unsigned char* uPlane = yPlane + width * height;
+	const unsigned char* vPlane = uPlane + (width/2) * (height/2);
+
+	for(int row=0; row < height; row+=2){
+		i420ToBgrRows(yPlane + row * width, yPlane + (row+1) * width, uPlane + (row/2) * (width/2),
+				vPlane + (row/2) * (width/2), bgr.ptr(row), bgr.ptr(row+1), width);
+	}
+	return true;
+}
+
+// converts two BGR rows into two luma rows and one row of each chroma plane
+void YUVConverter::bgrToI420Rows(const unsigned char* bgr0, const unsigned char* bgr1, unsigned char* y0,
+		unsigned char* y1, unsigned char* u, unsigned char* v, int width){
+
+	int x = 0;
+
+#ifdef __SSE2__
+	const __m128i cUR = _mm_set1_epi16(YUV_U_R);
+	const __m128i cUG = _mm_set1_epi16(YUV_U_G);
+	const __m128i cVG = _mm_set1_epi16(YUV_V_G);
+	const __m128i cVB = _mm_set1_epi16(YUV_V_B);
+	const __m128i offset = _mm_set1_epi16(128);
+
+	for(; x + 32 <= width; x += 32){
+		__m128i p0[6], p1[6];
+		loadBGR32(bgr0 + 3*x, p0);
+		loadBGR32(bgr1 + 3*x, p1);
+
+		// luma of both rows
+		_mm_storeu_si128((__m128i*)(y0 + x), lumaBGR16(p0[0], p0[2], p0[4]));
+		_mm_storeu_si128((__m128i*)(y0 + x + 16), lumaBGR16(p0[1], p0[3], p0[5]));
+		_mm_storeu_si128((__m128i*)(y1 + x), lumaBGR16(p1[0], p1[2], p1[4]));
+		_mm_storeu_si128((__m128i*)(y1 + x + 16), lumaBGR16(p1[1], p1[3], p1[5]));
+
+		// chroma of the averaged 2x2 blocks
+		__m128i uv[2][2];
+		for(int i=0; i < 2; i++){
+			__m128i b = average2x2(p0[i], p1[i]);
+			__m128i g = average2x2(p0[2+i], p1[2+i]);
+			__m128i r = average2x2(p0[4+i], p1[4+i]);
+			__m128i cu = _mm_sub_epi16(_mm_sub_epi16(_mm_slli_epi16(b, 7), _mm_mullo_epi16(r, cUR)), _mm_mullo_epi16(g, cUG));
+			__m128i cv = _mm_sub_epi16(_mm_sub_epi16(_mm_slli_epi16(r, 7), _mm_mullo_epi16(g, cVG)), _mm_mullo_epi16(b, cVB));
+			uv[0][i] = _mm_add_epi16(_mm_srai_epi16(cu, 8), offset);
+			uv[1][i] = _mm_add_epi16(_mm_srai_epi16(cv, 8), offset);
+		}
+		_mm_storeu_si128((__m128i*)(u + x/2), _mm_packus_epi16(uv[0][0], uv[0][1]));
+		_mm_storeu_si128((__m128i*)(v + x/2), _mm_packus_epi16(uv[1][0], uv[1][1]));
+	}
+#endif
+
+	for(; x < width; x += 2){
+		const unsigned char* p00 = bgr0 + 3*x;
+		const unsigned char* p01 = bgr0 + 3*x + 3;
+		const unsigned char* p10 = bgr1 + 3*x;
+		const unsigned char* p11 = bgr1 + 3*x + 3;
+
+		y0[x]   = (YUV_Y_R*p00[2] + YUV_Y_G*p00[1] + YUV_Y_B*p00[0] + 128) >> 8;
+		y0[x+1] = (YUV_Y_R*p01[2] + YUV_Y_G*p01[1] + YUV_Y_B*p01[0] + 128) >> 8;
+		y1[x]   = (YUV_Y_R*p10[2] + YUV_Y_G*p10[1] + YUV_Y_B*p10[0] + 128) >> 8;
+		y1[x+1] = (YUV_Y_R*p11[2] + YUV_Y_G*p11[1] + YUV_Y_B*p11[0] + 128) >> 8;
+
+		int b = (p00[0] + p01[0] + p10[0] + p11[0] + 2) >> 2;
+		int g = (p00[1] + p01[1] + p10[1] + p11[1] + 2) >> 2;
+		int r = (p00[2] + p01[2] + p10[2] + p11[2] + 2) >> 2;
+
+		u[x/2] = saturate(((128*b - YUV_U_R*r - YUV_U_G*g) >> 8) + 128);
+		v[x/2] = saturate(((128*r - YUV_V_G*g - YUV_V_B*b) >> 8) + 128);
+	}
+}
+
+// converts two luma rows and the corresponding chroma rows into two BGR rows
+void YUVConverter::i420ToBgrRows(const unsigned char* y0, const unsigned char* y1, const unsigned char* u,
+		const unsigned char* v, unsigned char* bgr0, unsigned char* bgr1, int width){
+
+	int x = 0;
+
+#ifdef __SSE2__
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i offset = _mm_set1_epi16(128);
+	const __m128i round = _mm_set1_epi16(64);
+	const __m128i cRV = _mm_set1_epi16(YUV_R_V);
+	const __m128i cGU = _mm_set1_epi16(YUV_G_U);
+	const __m128i cGV = _mm_set1_epi16(YUV_G_V);
+	const __m128i cBU = _mm_set1_epi16(YUV_B_U);
+
+	for(; x + 32 <= width; x += 32){
+		__m128i cu = _mm_loadu_si128((const __m128i*)(u + x/2));
+		__m128i cv = _mm_loadu_si128((const __m128i*)(v + x/2));
+
+		// chroma terms of 16 chroma samples (two halves of 8)
+		__m128i dr[2], dg[2], db[2];
+		for(int i=0; i < 2; i++){
+			__m128i d = _mm_sub_epi16(i == 0 ? _mm_unpacklo_epi8(cu, zero) : _mm_unpackhi_epi8(cu, zero), offset);
+			__m128i e = _mm_sub_epi16(i == 0 ? _mm_unpacklo_epi8(cv, zero) : _mm_unpackhi_epi8(cv, zero), offset);
+			dr[i] = _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(e, cRV), round), 7);
+			dg[i] = _mm_srai_epi16(_mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(d, cGU), _mm_mullo_epi16(e, cGV)), round), 7);
+			db[i] = _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(d, cBU), round), 7);
+		}
+
+		const unsigned char* yRows[2] = {y0, y1};
+		unsigned char* dstRows[2] = {bgr0, bgr1};
+		for(int row=0; row < 2; row++){
+			__m128i p[6];
+			for(int half=0; half < 2; half++){
+				__m128i luma = _mm_loadu_si128((const __m128i*)(yRows[row] + x + 16*half));
+				__m128i lumaLo = _mm_unpacklo_epi8(luma, zero);
+				__m128i lumaHi = _mm_unpackhi_epi8(luma, zero);
+
+				// every chroma sample belongs to two neighbouring pixels
+				__m128i rLo = _mm_unpacklo_epi16(dr[half], dr[half]), rHi = _mm_unpackhi_epi16(dr[half], dr[half]);
+				__m128i gLo = _mm_unpacklo_epi16(dg[half], dg[half]), gHi = _mm_unpackhi_epi16(dg[half], dg[half]);
+				__m128i bLo = _mm_unpacklo_epi16(db[half], db[half]), bHi = _mm_unpackhi_epi16(db[half], db[half]);
+
+				p[half]   = _mm_packus_epi16(_mm_add_epi16(lumaLo, bLo), _mm_add_epi16(lumaHi, bHi));
+				p[2+half] = _mm_packus_epi16(_mm_sub_epi16(lumaLo, gLo), _mm_sub_epi16(lumaHi, gHi));
+				p[4+half] = _mm_packus_epi16(_mm_add_epi16(lumaLo, rLo), _mm_add_epi16(lumaHi, rHi));
+			}
+			storeBGR32(dstRows[row] + 3*x, p);
+		}
+	}
+#endif
+
+	for(; x < width; x += 2){
+		int d = u[x/2] - 128;
+		int e = v[x/2] - 128;
+		int dr = (YUV_R_V*e + 64) >> 7;
+		int dg = (YUV_G_U*d + YUV_G_V*e + 64) >> 7;
+		int db = (YUV_B_U*d + 64) >> 7;
+
+		const unsigned char* yRows[2] = {y0, y1};
+		unsigned char* dstRows[2] = {bgr0, bgr1};
+		for(int row=0; row < 2; row++){
+			for(int i=0; i < 2; i++){
+				int luma = yRows[row][x+i];
+				unsigned char* p = dstRows[row] + 3*(x+i);
+				p[0] = saturate(luma + db);
+				p[1] = saturate(luma - dg);
+				p[2] = saturate(luma + dr);
+			}
+		}
+	}
+}
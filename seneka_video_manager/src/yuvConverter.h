@@ -0,0 +1,88 @@
+/*!
+ *****************************************************************
+ * \file
+ *
+ * \note
+ *   Copyright (c) 2012 \n
+ *   Fraunhofer Institute for Manufacturing Engineering
+ *   and Automation (IPA) \n\n
+ *
+ *****************************************************************
+ *
+ * \note
+ *   Project name: SENEKA
+ * \note
+ *   ROS stack name: SENEKA
+ * \note
+ *   ROS package name: seneka_video_manager
+ *
+ * \author
+ *   Author: Johannes Goth (cmm-jg)
+ * \author
+ *   Supervised by: Christophe Maufroy (cmm)
+ *
+ * \date Date of creation: 19.10.2026
+ *
+ * \brief
+ *   yuvConverter.h
+ *
+ *****************************************************************
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     - Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer. \n
+ *     - Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution. \n
+ *     - Neither the name of the Fraunhofer Institute for Manufacturing
+ *       Engineering and Automation (IPA) nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission. \n
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************/
+
+#ifndef YUVCONVERTER_H_
+#define YUVCONVERTER_H_
+
+// openCV includes
+#include "opencv2/core/core.hpp"
+
+/* Conversion between BGR8 frames and planar YUV 4:2:0 (I420) frames
+ * The I420 frame is a single channel cv::Mat with rows*3/2 rows: the full resolution Y plane is followed by the
+ * U plane and the V plane, both subsampled by two in each direction. So a cached frame needs 1.5 instead of 3 bytes
+ * per pixel. The coefficients are full range BT.601 (JPEG) in fixed point arithmetic. The row kernels use SSE2 if
+ * it is available and a scalar implementation with identical results otherwise. */
+class YUVConverter {
+public:
+
+	// public member functions
+	static bool bgrToI420(const cv::Mat& bgr, cv::Mat& yuv);
+	static bool i420ToBgr(const cv::Mat& yuv, cv::Mat& bgr);
+	static bool isConvertible(const cv::Mat& bgr);
+
+private:
+
+	// private member functions
+	static void bgrToI420Rows(const unsigned char* bgr0, const unsigned char* bgr1, unsigned char* y0,
+			unsigned char* y1, unsigned char* u, unsigned char* v, int width);
+	static void i420ToBgrRows(const unsigned char* y0, const unsigned char* y1, const unsigned char* u,
+			const unsigned char* v, unsigned char* bgr0, unsigned char* bgr1, int width);
+};
+
+#endif /* YUVCONVERTER_H_ */
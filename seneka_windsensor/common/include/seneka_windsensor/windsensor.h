@@ -54,7 +54,9 @@
  ****************************************************************/
 #pragma once
 
-#include <boost/asio/serial_port.hpp>
+#include <seneka_serial/SerialPort.h>
+#include <seneka_serial/LineFramer.h>
+#include <boost/thread.hpp>
 
 #include <math.h>
 #include <iostream>
@@ -95,16 +97,32 @@ public:
         float convert_direction_from_degree(float degree, int unit);
         float convert_temperature_from_centigrade(float centigrade, int unit);
 
-        bool compare_checksum(string fields[], std::string line_for_checksum);
-        bool extract_sensordata_from_buffer(unsigned char *input, float sensor_values[]);
+        bool compare_checksum(const std::string& line);
+        bool extract_sensordata_from_line(const std::string& line);
         
+        // waits for the next complete measurement (wind and temperature sentence) received after the last call
         bool read(float sensor_values[], string sensor_units[]);
         bool open(const char* pcPort, int iBaudRate);
         void close();
 
 private:
-        // serial input/output instance;
-        boost::asio::io_service io_service_;
-        boost::asio::serial_port m_SerialIO;
+        // serial input/output instance, read by the shared reactor thread (see seneka_serial/SerialPort.h)
+        SerialPort serial_port;
+
+        // called by the reactor thread, the received sentences are parsed as soon as they are complete
+        void handle_receive(const unsigned char* data, size_t size);
+        void handle_read_error(const boost::system::error_code& ec);
+
+        // guards the members below
+        boost::mutex measurement_mutex;
+        boost::condition_variable measurement_condition;
+        LineFramer framer;
+        float wind_speed;
+        float wind_direction;
+        float temperature;
+        bool got_wind;              // since the last read()
+        bool got_temperature;       // since the last read()
+        bool read_failed;
+        std::string read_error;     // cause of the read failure
 };
 
@@ -54,59 +54,13 @@
  ****************************************************************/
 #include <seneka_windsensor/windsensor.h>
 #include <ros/ros.h>
-#include <boost/optional.hpp>
-#include <boost/asio/deadline_timer.hpp>
 #include <boost/bind.hpp> 
-#include <boost/asio.hpp>
 #include <boost/thread.hpp>
 
 using namespace std;
 
-typedef unsigned char BYTE;
-
-void set_result1(boost::optional<boost::system::error_code>* a, boost::system::error_code b) 
-{ 
-	a->reset(b);
-} 
-void set_result2(boost::optional<boost::system::error_code>* a, boost::system::error_code b, size_t *bytes_transferred, size_t _bytes_transferred) 
-{ 
-	a->reset(b);
-	*bytes_transferred = _bytes_transferred;
-} 
-
-
-template <typename MutableBufferSequence> 
-int read_with_timeout(boost::asio::serial_port& sock, 
-  const MutableBufferSequence& buffers) 
-{ 
-	boost::optional<boost::system::error_code> timer_result; 
-	boost::asio::deadline_timer timer(sock.io_service()); 
-	timer.expires_from_now(boost::posix_time::milliseconds(500)); 
-	timer.async_wait(boost::bind(set_result1, &timer_result, _1)); 
-
-
-	size_t bytes_to_transfer = 0;
-	boost::optional<boost::system::error_code> read_result; 
-	boost::asio::async_read(sock, buffers, 
-		boost::bind(set_result2, &read_result, _1, &bytes_to_transfer, boost::asio::placeholders::bytes_transferred)); 
-
-	sock.io_service().reset(); 
-	while (sock.io_service().run_one()) 
-	{ 
-	  if (read_result) 
-		timer.cancel(); 
-	  else if (timer_result) 
-		sock.cancel(); 
-	} 
-
-
-	if (*read_result && !(*read_result==boost::asio::error::operation_aborted && bytes_to_transfer>0) ) {
-		std::cout<<"error code: "<<(*read_result)<<std::endl;
-	  return 0; //throw boost::system::system_error(*read_result);
-	  }
-	  
-	return bytes_to_transfer;
-} 
+// maximum time in ms read() waits for the next measurement
+#define READ_TIMEOUT ( 500 )
 
 int sensor_port = 0;
 int sensor_baudrate = 0;
@@ -119,53 +73,80 @@ int direction_unit = 0;     // degree = 0
 int temperature_unit = 0;   // centigrade = 0
                             // fahrenheit = 1
 
-windsensor::windsensor(int in_speed_unit, int in_direction_unit, int in_temperature_unit) : m_SerialIO(io_service_) {
+windsensor::windsensor(int in_speed_unit, int in_direction_unit, int in_temperature_unit) : framer('$') {
     speed_unit = in_speed_unit;
     direction_unit = in_direction_unit;
     temperature_unit = in_temperature_unit;
-    
-	boost::thread t(boost::bind(&boost::asio::io_service::run, &io_service_));
+
+    wind_speed = 0;
+    wind_direction = 0;
+    temperature = 0;
+    got_wind = false;
+    got_temperature = false;
+    read_failed = false;
 }
 
 windsensor::~windsensor() {
-    m_SerialIO.close();
+    close();
 }
 
 bool windsensor::open(const char* pcPort, int iBaudRate) {
 
-    //now comes a hack...
-    char buf[256];
-    sprintf(buf, "stty -F %s ispeed %d ospeed %d", pcPort, iBaudRate, iBaudRate);
-    system(buf);
+    close();
 
-    // open port;
+    framer.reset();
+    got_wind = false;
+    got_temperature = false;
+    read_failed = false;
+
+    // open and configure port (raw mode, 8N1, low latency, exclusive access), received sentences are parsed by the reactor thread
     boost::system::error_code ec;
-    m_SerialIO.open(pcPort, ec);
+    serial_port.open(pcPort, iBaudRate,
+                     boost::bind(&windsensor::handle_receive, this, _1, _2),
+                     boost::bind(&windsensor::handle_read_error, this, _1),
+                     ec);
     
     if(!ec) {
         connected = true;
         ROS_DEBUG("serial connection opened successfully");
+        if (!serial_port.lowLatency()) {
+            ROS_INFO("low latency mode is not supported by the serial driver of %s", pcPort);
+        }
         return true;
     } else {
         connected = false;
-        ROS_ERROR("could not connect to serial device");
+        ROS_ERROR("could not connect to serial device (%s)", ec.message().c_str());
         return false;
     }
-    
-    m_SerialIO.set_option(boost::asio::serial_port_base::baud_rate(iBaudRate), ec);
-    if(ec) ROS_ERROR("failed apply settings (%s, %d)", ec.category().name(), (int)ec.value());
-	m_SerialIO.set_option(boost::asio::serial_port_base::character_size(8), ec);
-    if(ec) ROS_ERROR("failed apply settings (%s, %d)", ec.category().name(), (int)ec.value());
-	m_SerialIO.set_option(boost::asio::serial_port_base::stop_bits(boost::asio::serial_port_base::stop_bits::one), ec);
-    if(ec) ROS_ERROR("failed apply settings (%s, %d)", ec.category().name(), (int)ec.value());
-	m_SerialIO.set_option(boost::asio::serial_port_base::parity(boost::asio::serial_port_base::parity::none), ec);
-    if(ec) ROS_ERROR("failed apply settings (%s, %d)", ec.category().name(), (int)ec.value());
-	m_SerialIO.set_option(boost::asio::serial_port_base::flow_control(boost::asio::serial_port_base::flow_control::none), ec);
-    if(ec) ROS_ERROR("failed apply settings (%s, %d)", ec.category().name(), (int)ec.value());
 }
 
 void windsensor::close() {
-    m_SerialIO.close();
+    serial_port.close();
+    connected = false;
+}
+
+void windsensor::handle_receive(const unsigned char* data, size_t size) {
+    bool measurement_complete = false;
+    {
+        boost::mutex::scoped_lock lock(measurement_mutex);
+        framer.push(data, size);
+        while (framer.next()) {
+            extract_sensordata_from_line(framer.line());
+        }
+        measurement_complete = got_wind && got_temperature;
+    }
+    if (measurement_complete) {
+        measurement_condition.notify_all();
+    }
+}
+
+void windsensor::handle_read_error(const boost::system::error_code& ec) {
+    {
+        boost::mutex::scoped_lock lock(measurement_mutex);
+        read_failed = true;
+        read_error = ec.message();
+    }
+    measurement_condition.notify_all();
 }
 
 float convert_speed_from_knots(float knots, int unit=speed_unit){
@@ -224,7 +205,7 @@ float convert_temperature_from_centigrade(float centigrade, int unit=temperature
     return result;
 }
 
-bool windsensor::compare_checksum(string fields[], std::string line_for_checksum){
+bool windsensor::compare_checksum(const std::string& line){
             bool checksum_ok = false;
             // calculate checksum and verify message
             /*      A sentence may contain up to 80 characters plus "$" and CR/LF.
@@ -233,17 +214,19 @@ bool windsensor::compare_checksum(string fields[], std::string line_for_checksum
              *       field consists of a "*" and two hex digits representing the exclusive OR of all characters between, but not
              *       including, the "$" and "*"
              */
-            std::string checksum = fields[5].substr(fields[5].length()-2, fields[5].length());
+            size_t checksum_pos = line.rfind('*');
+            if (checksum_pos == std::string::npos || checksum_pos + 3 != line.length()){
+                ROS_ERROR("message from windsensor has no checksum");
+                return false;
+            }
             // calculate checksum (XOR over int-values of all characters between $ and *
-            std::string message = line_for_checksum.substr(1,line_for_checksum.length()-4);
-            // calculate XOR
             int bitwise_xor = 0;
-            for (int i = 0; i<message.length(); i++){
-                bitwise_xor ^= message[i];
+            for (size_t i = 1; i < checksum_pos; i++){
+                bitwise_xor ^= line[i];
             }
             // convert received checksum value (hex) to int
             int checksum_int;
-            checksum_int = (int)strtol(checksum.c_str(), NULL, 16);
+            checksum_int = (int)strtol(line.substr(checksum_pos + 1).c_str(), NULL, 16);
             // compare checksums
             if (checksum_int == bitwise_xor){
                 ROS_DEBUG("checksum verfied for message from windsensor");
@@ -255,99 +238,37 @@ bool windsensor::compare_checksum(string fields[], std::string line_for_checksum
             return checksum_ok;
 }
 
-bool windsensor::extract_sensordata_from_buffer(unsigned char *input, float sensor_values[]){
-    // bool for return value
-    bool success = false;
-    // other variables
-    float wind_speed = 0;
-    bool got_wind_speed = false;
-    float wind_direction = 0;
-    bool got_wind_direction = false;
-    float temperature = 0;
-    bool got_temperature = false;
-    bool wind_checksum_ok = false;
-    bool temperature_checksum_ok = false;
-    // convert char* to string
-    std::string fields[6] = {""};
-    std::string s = reinterpret_cast<const char*>(input);
-
-    // extract values
-    std::string delimiter = "\r\n";             // line endings
-    std::string second_delimiter = ",";          // field delimiter
+// parses a single NMEA 0183 sentence (starting with '$', without CR/LF), measurement_mutex has to be locked
+bool windsensor::extract_sensordata_from_line(const std::string& line){
+    // split line into fields
+    std::vector<std::string> fields;
+    size_t start = 0;
     size_t pos = 0;
-    std::string line;
-    // find lines in buffer
-    while ((pos = s.find(delimiter)) != std::string::npos) {
-        line = s.substr(0, pos);
-        std::string line_for_checksum = s.substr(0, line.length());
-        // check if message starts with '$'  (start character for NMEA0183)
-        if (line[0] == '$'){
-        // extract fields
-        size_t second_pos = 0;
-        std::string field;
-        int field_counter = 0;
-        // find fields in line
-        while ((second_pos = line.find(second_delimiter)) != std::string::npos) {
-            // get substring between delimiters (',')
-            field = line.substr(0, second_pos);
-            // put field value into fields array
-            fields[field_counter] = field;
-            field_counter++;
-            // delete processed data from line-buffer
-            line.erase(0, second_pos + second_delimiter.length());
+    while ((pos = line.find(',', start)) != std::string::npos) {
+        fields.push_back(line.substr(start, pos - start));
+        start = pos + 1;
+    }
+    fields.push_back(line.substr(start));
+
+    // if line is wind_data (starts with "$IIMWV")
+    if (fields[0] == "$IIMWV" && fields.size() > 3){
+        if (compare_checksum(line) == true){
+            // extract wind direction and speed
+            wind_direction = strtof(fields[1].c_str(), NULL);
+            wind_speed = strtof(fields[3].c_str(), NULL);
+            got_wind = true;
+            return true;
         }
-        // add the last field to fields array ( to allow comparing data to received checksum )
-        fields[field_counter] = line.substr(0, line.length());
-        // now analyze values
-        // if line is wind_data (starts with "$IIMWV")
-        if (fields[0] == "$IIMWV"){
-            // extract wind direction
-            char * direction_char = new char[fields[1].length()];
-            strcpy(direction_char,fields[1].c_str());
-            wind_direction = strtof(direction_char, NULL);
-            // extract wind speed
-            char * speed_char = new char[fields[3].length()];
-            strcpy(speed_char,fields[3].c_str());
-            wind_speed = strtof(speed_char, NULL);
-            // verify checksum
-            if (compare_checksum(fields, line_for_checksum) == true){
-                got_wind_direction = true;
-                got_wind_speed = true;
-                wind_checksum_ok = true;
-            }
-        // else if line is temperature_data (starts with "$WIXDR")
-        }else if (fields[0] == "$WIXDR"){
+    // else if line is temperature_data (starts with "$WIXDR")
+    }else if (fields[0] == "$WIXDR" && fields.size() > 2){
+        if (compare_checksum(line) == true){
             // extract temperature value
-            char * temperature_char = new char[fields[2].length()];
-            strcpy(temperature_char,fields[2].c_str());
-            temperature = strtof(temperature_char, NULL);
-            // verify checksum
-            if (compare_checksum(fields, line_for_checksum) == true){
-                got_temperature = true;
-                temperature_checksum_ok = true;
-            }
-        }
-        // remove processed line from 'buffer'
-        s.erase(0, pos + delimiter.length());
+            temperature = strtof(fields[2].c_str(), NULL);
+            got_temperature = true;
+            return true;
         }
-        else{
-            // clean 'buffer' after failed extraction
-            int start_index = s.find("$");
-            s.erase(0, start_index);
-            ROS_DEBUG("message from windsensor did not start with \'$\'. skipping some bytes and retrying.");
-        }
-    }
-    // check if all values were ok
-    if (got_wind_speed && got_wind_direction && got_temperature && wind_checksum_ok && temperature_checksum_ok){
-        sensor_values[0] = wind_speed;
-        sensor_values[1] = wind_direction;
-        sensor_values[2] = temperature;
-        ROS_DEBUG("extracted all values from windsensor");
-        success = true;
-    }else{
-        ROS_WARN("could not extract windsensor values (publishrate too high?)");
     }
-    return success;
+    return false;
 }
 
 bool windsensor::read(float sensor_values[], string sensor_units[]){
@@ -357,15 +278,37 @@ bool windsensor::read(float sensor_values[], string sensor_units[]){
         ROS_ERROR("could not read from windsensor: %i, %i", sensor_port, sensor_baudrate);
     }
     else{
-        unsigned char Buffer[1024] = {0};                                           // increased Buffer from 512 to 1024	// 31.10.2013 David:	buffer[512] too small to read  1020 bytes ..??
-        int bytesread;
-        int iResultsFound = 0;
-        // read from serial
-		bytesread = read_with_timeout(m_SerialIO, boost::asio::buffer(Buffer,sizeof(Buffer)));
-        success = true;
-        ROS_DEBUG("read %i bytes from windsensor: %i, %i", bytesread, sensor_port, sensor_baudrate);
-        // extract sensor values and set sensor units
-        if (extract_sensordata_from_buffer(Buffer, sensor_values)){
+        // the sentences are received and parsed by the reactor thread, wait for the next complete measurement
+        bool got_values = false;
+        std::string error;
+        {
+            boost::system_time deadline = boost::get_system_time() + boost::posix_time::milliseconds(READ_TIMEOUT);
+            boost::mutex::scoped_lock lock(measurement_mutex);
+            while (!read_failed && !(got_wind && got_temperature)) {
+                if (!measurement_condition.timed_wait(lock, deadline)) {
+                    break;
+                }
+            }
+            success = !read_failed;
+            error = read_error;
+            got_values = got_wind && got_temperature;
+            if (got_values){
+                sensor_values[0] = wind_speed;
+                sensor_values[1] = wind_direction;
+                sensor_values[2] = temperature;
+                got_wind = false;
+                got_temperature = false;
+            }
+        }
+        if (!success){
+            ROS_ERROR("reading from windsensor failed: %s", error.c_str());
+        }
+        else if (!got_values){
+            ROS_WARN("could not extract windsensor values (publishrate too high?)");
+        }
+        // set sensor units
+        if (got_values){
+            ROS_DEBUG("extracted all values from windsensor");
             switch(speed_unit){
                 case 0:
                     sensor_units[0] = "knots";
@@ -58,7 +58,7 @@
 //##################
 //#### includes ####
 #include <ros/ros.h>
-#include <diagnostic_msgs/DiagnosticArray.h>
+#include <seneka_diagnostics/DiagnosticsAggregator.h>
 #include <seneka_windsensor/windsensor.h>
 #include <sstream>
 #include <seneka_windsensor/WindData.h>
@@ -75,7 +75,7 @@ public:
     ros::NodeHandle nh;
     // Publishers
     ros::Publisher topicPub_wind;
-    ros::Publisher topicPub_Diagnostic_;
+    DiagnosticsAggregator diagnostics; // published once per second
     ros::Time syncedROSTime;
     // Constructor:              rate can use fractions of 1.0 ( 0.5 publishes once every 2 seconds )
 
@@ -96,7 +96,7 @@ public:
         syncedROSTime = ros::Time::now();
         // advertise topics
         topicPub_wind = nh.advertise<seneka_windsensor::WindData > (topic, 1);
-        topicPub_Diagnostic_ = nh.advertise<diagnostic_msgs::DiagnosticArray > ("/diagnostics", 1);
+        diagnostics.start(nh, "/diagnostics", 1.0);
     }
 
     // Destructor
@@ -120,21 +120,13 @@ public:
         topicPub_wind.publish(value);
 
         //	 ROS_INFO("...publishing wind of windsensor");
-        diagnostic_msgs::DiagnosticArray diagnostics;
-        diagnostics.status.resize(1);
-        diagnostics.status[0].level = 0;
-        diagnostics.status[0].name = nh.getNamespace();
-        diagnostics.status[0].message = "Wind sensor running";
-        topicPub_Diagnostic_.publish(diagnostics);
+        diagnostics.setStatus(nh.getNamespace(), DiagnosticsAggregator::OK, "Wind sensor running");
     }
 
     void publishError(std::string error_str) {
-        diagnostic_msgs::DiagnosticArray diagnostics;
-        diagnostics.status.resize(1);
-        diagnostics.status[0].level = 2;
-        diagnostics.status[0].name = nh.getNamespace();
-        diagnostics.status[0].message = error_str;
-        topicPub_Diagnostic_.publish(diagnostics);
+        diagnostics.setStatus(nh.getNamespace(), DiagnosticsAggregator::ERROR, error_str);
+        // called while waiting for the sensor, i.e. without spinning the node
+        diagnostics.flush();
     }
 };
 